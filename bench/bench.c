@@ -0,0 +1,61 @@
+/** 
+ * --------------------------------------------------------------------------------------+  
+ * @name        SSD1306 benchmark - C API
+ * --------------------------------------------------------------------------------------+ 
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        bench.c
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      lib/ssd1306.h, lib/probe.h
+ * --------------------------------------------------------------------------------------+ 
+ * @brief       Same frame as bench.cpp drawn by the C API. Drawing is timed by probe
+ *              bit SSD1306_PROBE_APP0, update by SSD1306_PROBE_APP1, cycles are printed
+ *              by tools/ssd1306_vcd. Built and compared by 'make bench'.
+ * --------------------------------------------------------------------------------------+ 
+ */
+
+// include libraries
+#include "lib/ssd1306.h"
+#include "lib/probe.h"
+
+/**
+ * @desc    Main function
+ *
+ * @param   void
+ *
+ * @return  int
+ */
+int main(void)
+{
+  // LCD INIT
+  // ------------------------------------------------------------------------------------- 
+  SSD1306_Init (SSD1306_ADDR);                                    // 0x3C
+
+  // DRAWING
+  // -------------------------------------------------------------------------------------
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_APP0);
+  SSD1306_ClearScreen ();                                         // clear screen
+  SSD1306_DrawLine (0, MAX_X, 4, 4);                              // draw line
+  SSD1306_SetPosition (7, 1);                                     // set position
+  SSD1306_DrawString ("SSD1306 OLED DRIVER");                     // draw string
+  SSD1306_DrawLine (0, MAX_X, 18, 18);                            // draw line
+  SSD1306_DrawLine (0, MAX_X, 31, 0);                             // draw diagonal
+  SSD1306_SetPosition (40, 3);                                    // set position
+  SSD1306_DrawString ("MATIASUS");                                // draw string
+  SSD1306_PROBE_END (SSD1306_PROBE_APP0);
+
+  // UPDATE
+  // -------------------------------------------------------------------------------------
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_APP1);
+  SSD1306_UpdateScreen (SSD1306_ADDR);                            // update
+  SSD1306_PROBE_END (SSD1306_PROBE_APP1);
+
+  // RETURN
+  // -------------------------------------------------------------------------------------
+  return 0;
+}
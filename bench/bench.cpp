@@ -0,0 +1,64 @@
+/** 
+ * --------------------------------------------------------------------------------------+  
+ * @name        SSD1306 benchmark - C++ front end
+ * --------------------------------------------------------------------------------------+ 
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        bench.cpp
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      lib/ssd1306.hpp, lib/probe.h
+ * --------------------------------------------------------------------------------------+ 
+ * @brief       Same frame as bench.c drawn by Ssd1306<128, 32, Ssd1306Twi<>>. Drawing
+ *              is timed by probe bit SSD1306_PROBE_APP0, update by SSD1306_PROBE_APP1.
+ * --------------------------------------------------------------------------------------+ 
+ */
+
+// include libraries
+#include "lib/ssd1306.hpp"
+#include "lib/probe.h"
+
+// @var display of the same size as compiled C library
+static Ssd1306<END_COLUMN_ADDR + 1, MAX_Y, Ssd1306Twi<SSD1306_ADDR> > oled;
+
+/**
+ * @desc    Main function
+ *
+ * @param   void
+ *
+ * @return  int
+ */
+int main(void)
+{
+  // LCD INIT
+  // ------------------------------------------------------------------------------------- 
+  SSD1306_PROBE_SETUP ();
+  oled.init ();
+
+  // DRAWING
+  // -------------------------------------------------------------------------------------
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_APP0);
+  oled.clear ();                                                  // clear screen
+  oled.drawLine (0, MAX_X, 4, 4);                                 // draw line
+  oled.setPosition (7, 1);                                        // set position
+  oled.drawString ("SSD1306 OLED DRIVER");                        // draw string
+  oled.drawLine (0, MAX_X, 18, 18);                               // draw line
+  oled.drawLine (0, MAX_X, 31, 0);                                // draw diagonal
+  oled.setPosition (40, 3);                                       // set position
+  oled.drawString ("MATIASUS");                                   // draw string
+  SSD1306_PROBE_END (SSD1306_PROBE_APP0);
+
+  // UPDATE
+  // -------------------------------------------------------------------------------------
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_APP1);
+  oled.update ();                                                 // update
+  SSD1306_PROBE_END (SSD1306_PROBE_APP1);
+
+  // RETURN
+  // -------------------------------------------------------------------------------------
+  return 0;
+}
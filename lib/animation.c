@@ -0,0 +1,211 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Delta encoded animations
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        animation.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      animation.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Spinners, boot logos, looped animations
+ */
+
+// @includes
+#include "animation.h"
+
+#if SSD1306_USE_BITMAPS
+
+// @var ticks incremented by SSD1306_AnimTick
+volatile uint8_t _animTicks;
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Animation send one span - every span is its own (repeated) START,
+ *          window commands and data stream; bus is released on failure, also for
+ *          span out of animation area or corrupted RLE payload
+ *
+ * @param   SSD1306_Anim *
+ * @param   const uint8_t ** span in PROGMEM, moved behind span payload
+ * @param   uint8_t open - previous span of frame left bus open
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_AnimSpan (SSD1306_Anim * player, const uint8_t ** span, uint8_t open)
+{
+  uint8_t status = INIT_STATUS;
+  const uint8_t * data = *span;
+  uint8_t page = pgm_read_byte (data++);
+  uint8_t column = pgm_read_byte (data++);
+  uint8_t length = pgm_read_byte (data++);
+  uint8_t rle = page & ANIM_SPAN_RLE;
+
+  // span inside animation area
+  // -------------------------------------------------------------------------------------
+  if ((0 == length) || ((page & ANIM_SPAN_PAGE) >= pgm_read_byte (&player->anim[ANIM_PAGES])) ||
+      ((column + length) > pgm_read_byte (&player->anim[ANIM_WIDTH]))) {
+    if (open) {
+      SSD1306_Send_Stop ();
+    }
+    return SSD1306_ERROR;
+  }
+  column += player->x;
+  page = (page & ANIM_SPAN_PAGE) + player->page;
+  // TWI: (repeated) start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (player->address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // window of span
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (column, column + length - 1, page, page);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // control byte data stream
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_DataStream ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // payload
+  // -------------------------------------------------------------------------------------
+  if (rle) {
+    status = SSD1306_Send_RLE_P (&data, length);
+  } else {
+    status = SSD1306_Send_Raw_P (data, length);
+    data += length;
+  }
+  *span = data;
+
+  return status;
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Animation init
+ *
+ * @param   SSD1306_Anim * player
+ * @param   const uint8_t * animation in PROGMEM
+ * @param   uint8_t address
+ * @param   uint8_t column -> 0 ... 127
+ * @param   uint8_t page -> 0 ... 7 or 3
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_AnimInit (SSD1306_Anim * player, const uint8_t * anim, uint8_t address, uint8_t x, uint8_t page)
+{
+  uint8_t y = page << 3;
+
+  // landscape only
+  // -------------------------------------------------------------------------------------
+  if (SSD1306_GetRotation () & SSD1306_PORTRAIT) {
+    return SSD1306_ERROR;
+  }
+  // check period & area, whole animation inside viewport, page aligned
+  // -------------------------------------------------------------------------------------
+  if ((0 == pgm_read_byte (&anim[ANIM_PERIOD])) ||
+      (SSD1306_SUCCESS != SSD1306_ViewportArea (&x, &y, pgm_read_byte (&anim[ANIM_WIDTH]),
+                                                pgm_read_byte (&anim[ANIM_PAGES]) << 3)) ||
+      (y & 0x07)) {
+    return SSD1306_ERROR;
+  }
+  page = y >> 3;
+  player->anim = anim;
+  player->frame = anim + ANIM_HEADER_SIZE;
+  player->loop = player->frame;
+  player->address = address;
+  player->x = x;
+  player->page = page;
+  player->index = 0;
+  player->last = _animTicks - pgm_read_byte (&anim[ANIM_PERIOD]);   // key frame at once
+  player->played = 0;
+  player->dropped = 0;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Animation play next frame immediately, spans are chained by repeated
+ *          START, so the whole frame is one bus session with a single STOP
+ *
+ * @param   SSD1306_Anim * player
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_AnimFrame (SSD1306_Anim * player)
+{
+  uint8_t status = INIT_STATUS;
+  const uint8_t * frame = player->frame;
+  uint8_t spans = pgm_read_byte (frame++);
+  uint8_t i;
+
+  // spans
+  // -------------------------------------------------------------------------------------
+  if (spans) {
+    for (i = 0; i < spans; i++) {
+      status = SSD1306_AnimSpan (player, &frame, i);
+      if (SSD1306_SUCCESS != status) {
+        return status;                                            // bus released
+      }
+    }
+    // TWI: Stop
+    // -----------------------------------------------------------------------------------
+    SSD1306_Send_Stop ();
+  }
+  // next frame
+  // -------------------------------------------------------------------------------------
+  if (0 == player->index) {                                       // key frame played
+    player->loop = frame;
+  }
+  if (player->index++ == pgm_read_byte (&player->anim[ANIM_FRAMES])) {
+    player->index = 1;                                            // loop delta played
+    frame = player->loop;
+  }
+  player->frame = frame;
+  player->played++;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Animation update, play next frame if its period elapsed; periods that
+ *          elapsed while the bus was busy are counted as dropped frames
+ *
+ * @param   SSD1306_Anim * player
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_AnimUpdate (SSD1306_Anim * player)
+{
+  uint8_t period = pgm_read_byte (&player->anim[ANIM_PERIOD]);
+  uint8_t elapsed = _animTicks - player->last;
+  uint8_t slots;
+
+  if (elapsed < period) {
+    return ANIM_IDLE;
+  }
+  slots = elapsed / period;
+  player->dropped += slots - 1;                                   // late frames
+  player->last += slots * period;                                 // keep time base
+
+  return SSD1306_AnimFrame (player);
+}
+
+#endif
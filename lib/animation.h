@@ -0,0 +1,122 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Delta encoded animations
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        animation.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      bitmap.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Animation stored in PROGMEM:
+ *
+ *              Header: | frames | width (columns) | pages | period (ticks) |
+ *              Frame:  | spans | span ... |
+ *              Span:   | page (+ ANIM_SPAN_RLE) | column | length | payload |
+ *
+ *              Stored frames are: key frame (whole area), deltas 1 ... frames-1 and the
+ *              loop delta back to frame 0, i.e. frames + 1 entries. Span page and column
+ *              are relative to the animation origin, payload holds new panel content of
+ *              the changed run (raw or RLE tokens, see bitmap.h).
+ *
+ *              Host encoder: tools/ssd1306_anim.py
+ * -------------------------------------------------------------------------------------+
+ * @usage       ISR (TIMER0_COMPA_vect) { SSD1306_AnimTick (); }
+ *
+ *              SSD1306_AnimInit (&spinner, SPINNER, SSD1306_ADDR, 56, 1);
+ *              while (1) { SSD1306_AnimUpdate (&spinner); ... }
+ */
+
+#ifndef __ANIMATION_H__
+#define __ANIMATION_H__
+
+  // @includes
+  #include "bitmap.h"
+
+  // Animation header
+  // ------------------------------------------------------------------------------------
+  #define ANIM_HEADER_SIZE          4
+  #define ANIM_FRAMES               0     // offset of number of frames
+  #define ANIM_WIDTH                1     // offset of width in columns
+  #define ANIM_PAGES                2     // offset of height in pages
+  #define ANIM_PERIOD               3     // offset of ticks per frame
+
+  // Span
+  // ------------------------------------------------------------------------------------
+  #define ANIM_SPAN_RLE             0x80  // payload is RLE coded
+  #define ANIM_SPAN_PAGE            0x07  // page mask
+
+  // Update status
+  // ------------------------------------------------------------------------------------
+  #define ANIM_IDLE                 2     // not yet time for next frame
+
+  // @var ticks incremented by SSD1306_AnimTick
+  extern volatile uint8_t _animTicks;
+
+  // Animation player
+  // ------------------------------------------------------------------------------------
+  typedef struct {
+    const uint8_t * anim;                 // container in PROGMEM
+    const uint8_t * frame;                // next frame to play
+    const uint8_t * loop;                 // first delta after key frame
+    uint8_t address;                      // display address
+    uint8_t x;                            // origin column
+    uint8_t page;                         // origin page
+    uint8_t index;                        // index of next frame, 0 = key frame
+    uint8_t last;                         // tick of last played frame
+    uint16_t played;                      // played frames
+    uint16_t dropped;                     // frame slots missed because bus was too slow
+  } SSD1306_Anim;
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Animation tick, call from timer interrupt
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  static inline void SSD1306_AnimTick (void) { _animTicks++; }
+
+  /**
+   * @brief   Animation init
+   *
+   * @param   SSD1306_Anim *
+   * @param   const uint8_t * animation in PROGMEM
+   * @param   uint8_t address
+   * @param   uint8_t column
+   * @param   uint8_t page
+   *
+   * @return  uint8_t SSD1306_ERROR also in portrait rotation
+   */
+  uint8_t SSD1306_AnimInit (SSD1306_Anim *, const uint8_t *, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Animation update, play next frame if its period elapsed
+   *
+   * @param   SSD1306_Anim *
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_AnimUpdate (SSD1306_Anim *);
+
+  /**
+   * @brief   Animation play next frame immediately
+   *
+   * @param   SSD1306_Anim *
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_AnimFrame (SSD1306_Anim *);
+
+#endif
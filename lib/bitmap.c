@@ -0,0 +1,280 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Bitmaps streamed from flash
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        bitmap.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      bitmap.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Splash screens, icons, full screen pictures
+ */
+
+// @includes
+#include "bitmap.h"
+
+#if SSD1306_USE_BITMAPS
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   SSD1306 Send raw data from flash
+ *
+ * @param   const uint8_t * data in PROGMEM
+ * @param   uint16_t number of bytes
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Raw_P (const uint8_t * data, uint16_t size)
+{
+  return SSD1306_Send_Buffer_P (data, size);
+}
+
+/**
+ * @brief   SSD1306 Decode RLE tokens from flash into data stream, bus is released on
+ *          failure (corrupted stream too)
+ *
+ * @param   const uint8_t ** data in PROGMEM, moved behind the last token used
+ * @param   uint16_t number of decoded bytes to send
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_RLE_P (const uint8_t ** data, uint16_t size)
+{
+  uint8_t status = INIT_STATUS;
+  const uint8_t * rle = *data;
+  uint8_t token;
+  uint8_t count;
+  uint8_t value;
+
+  while (size) {
+    token = pgm_read_byte (rle++);
+    count = (token & RLE_COUNT_MASK) + 1;
+    if (count > size) {                                           // corrupted stream
+      SSD1306_Send_Stop ();
+      return SSD1306_ERROR;
+    }
+    size -= count;
+    // literal
+    // -----------------------------------------------------------------------------------
+    if (RLE_LITERAL == (token & RLE_TYPE_MASK)) {
+      status = SSD1306_Send_Raw_P (rle, count);
+      rle += count;
+    // runs
+    // -----------------------------------------------------------------------------------
+    } else {
+      if (RLE_RUN == (token & RLE_TYPE_MASK)) {
+        value = pgm_read_byte (rle++);
+      } else {
+        value = (RLE_ZEROS == (token & RLE_TYPE_MASK)) ? 0x00 : 0xFF;
+      }
+      while (count--) {
+        status = SSD1306_Send_Data (value);
+        if (SSD1306_SUCCESS != status) {
+          break;
+        }
+      }
+    }
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+  }
+  *data = rle;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Draw bitmap in portrait - every 8x8 block is rotated by
+ *          SSD1306_Rotate8_P on the way to the panel. Strip of 8 logical columns is
+ *          one panel page, strips are sent from the last one (lowest panel page)
+ *          so the window is filled in horizontal addressing order. RLE data can't
+ *          be accessed by blocks and isn't supported here.
+ *
+ * @param   uint8_t address
+ * @param   uint8_t column -> 0 ... MAX_Y - 8, multiple of 8
+ * @param   uint8_t page -> logical row of 8 pixels
+ * @param   const uint8_t * bitmap in PROGMEM
+ * @param   const uint8_t * tile set in PROGMEM
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_DrawBitmapPortrait_P (uint8_t address, uint8_t x, uint8_t page, const uint8_t * bitmap, const uint8_t * tiles)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t format = pgm_read_byte (&bitmap[BITMAP_FORMAT]);
+  uint8_t width = pgm_read_byte (&bitmap[BITMAP_WIDTH]);
+  uint8_t pages = pgm_read_byte (&bitmap[BITMAP_PAGES]);
+  const uint8_t * data = bitmap + BITMAP_HEADER_SIZE;
+  const uint8_t * block;
+  uint8_t strips = width >> 3;
+  uint8_t last = END_PAGE_ADDR - (x >> 3);                        // panel page of strip 0
+  uint8_t rotated[8];
+  uint8_t strip;
+  uint8_t row;
+
+  // check area
+  // -------------------------------------------------------------------------------------
+  if ((0 == strips) || (width & 0x07) || (x & 0x07) || (BITMAP_RLE == format)) {
+    return SSD1306_ERROR;
+  }
+  if (((x + width) > MAX_Y) || ((page + pages) > ((END_COLUMN_ADDR + 1) >> 3))) {
+    return SSD1306_ERROR;
+  }
+  if ((BITMAP_TILED == format) && (NULL == tiles)) {
+    return SSD1306_ERROR;
+  }
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // window - logical rows are panel columns, strips are panel pages
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (page << 3, ((page + pages) << 3) - 1, last - strips + 1, last);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // control byte data stream
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_DataStream ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // blocks
+  // -------------------------------------------------------------------------------------
+  strip = strips;
+  while (strip--) {
+    for (row = 0; row < pages; row++) {
+      if (BITMAP_TILED == format) {
+        block = tiles + pgm_read_byte (&data[row * strips + strip]) * BITMAP_TILE_SIZE;
+      } else {
+        block = data + row * width + (strip << 3);
+      }
+      SSD1306_Rotate8_P (block, 8, rotated);
+      status = SSD1306_Send_Buffer (rotated, 8);
+      if (SSD1306_SUCCESS != status) {
+        return status;
+      }
+    }
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Draw bitmap with shared tile set from flash directly to display;
+ *          raw and RLE bitmaps are drawn too, the tile set is then not used
+ *
+ * @param   uint8_t address
+ * @param   uint8_t column -> 0 ... 127
+ * @param   uint8_t page -> 0 ... 7 or 3
+ * @param   const uint8_t * bitmap in PROGMEM
+ * @param   const uint8_t * tile set in PROGMEM
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_DrawBitmapTiled_P (uint8_t address, uint8_t x, uint8_t page, const uint8_t * bitmap, const uint8_t * tiles)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t format = pgm_read_byte (&bitmap[BITMAP_FORMAT]);
+  uint8_t width = pgm_read_byte (&bitmap[BITMAP_WIDTH]);
+  uint8_t pages = pgm_read_byte (&bitmap[BITMAP_PAGES]);
+  uint16_t size = width * pages;
+  const uint8_t * data = bitmap + BITMAP_HEADER_SIZE;
+  uint16_t tile;
+  uint8_t y = page << 3;
+
+  // viewport - whole bitmap inside clip, page aligned
+  // -------------------------------------------------------------------------------------
+  if ((SSD1306_SUCCESS != SSD1306_ViewportArea (&x, &y, width, pages << 3)) || (y & 0x07)) {
+    return SSD1306_ERROR;
+  }
+  page = y >> 3;
+  // portrait
+  // -------------------------------------------------------------------------------------
+  if (SSD1306_GetRotation () & SSD1306_PORTRAIT) {
+    return SSD1306_DrawBitmapPortrait_P (address, x, page, bitmap, tiles);
+  }
+  // check area
+  // -------------------------------------------------------------------------------------
+  if ((0 == size) || ((x + width) > RAM_X_END) || ((page + pages) > RAM_Y_END)) {
+    return SSD1306_ERROR;
+  }
+  if ((BITMAP_TILED == format) && ((NULL == tiles) || (width % BITMAP_TILE_SIZE))) {
+    return SSD1306_ERROR;
+  }
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // window of bitmap
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (x, x + width - 1, page, page + pages - 1);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // control byte data stream
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_DataStream ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // data
+  // -------------------------------------------------------------------------------------
+  if (BITMAP_RLE == format) {
+    status = SSD1306_Send_RLE_P (&data, size);
+  } else if (BITMAP_TILED == format) {
+    size /= BITMAP_TILE_SIZE;                                     // number of tiles
+    while (size--) {
+      tile = pgm_read_byte (data++) * BITMAP_TILE_SIZE;
+      status = SSD1306_Send_Raw_P (tiles + tile, BITMAP_TILE_SIZE);
+      if (SSD1306_SUCCESS != status) {
+        break;
+      }
+    }
+  } else {
+    status = SSD1306_Send_Raw_P (data, size);
+  }
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Draw bitmap from flash directly to display
+ *
+ * @param   uint8_t address
+ * @param   uint8_t column -> 0 ... 127
+ * @param   uint8_t page -> 0 ... 7 or 3
+ * @param   const uint8_t * bitmap in PROGMEM
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_DrawBitmap_P (uint8_t address, uint8_t x, uint8_t page, const uint8_t * bitmap)
+{
+  return SSD1306_DrawBitmapTiled_P (address, x, page, bitmap, NULL);
+}
+
+#endif
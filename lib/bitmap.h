@@ -0,0 +1,119 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Bitmaps streamed from flash
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        bitmap.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Bitmaps are stored in PROGMEM in page format (1 byte = 8 vertical pixels,
+ *              LSB on top) and decoded directly into the TWI data stream. The window
+ *              is set by SET_COLUMN_ADDR / SET_PAGE_ADDR, so 'cacheMemLcd' is bypassed.
+ *
+ *              Header: | format | width (columns) | pages | data ... |
+ *
+ *              BITMAP_RLE token (1 byte) followed by payload:
+ *                00cc cccc - literal, (c + 1) bytes follow
+ *                01cc cccc - run, next byte repeated (c + 1) times
+ *                10cc cccc - run of (c + 1) bytes 0x00, no payload
+ *                11cc cccc - run of (c + 1) bytes 0xFF, no payload
+ *
+ *              BITMAP_TILED data is one index per 8x8 tile (row major) into a tile set
+ *              of 8 byte tiles shared by several bitmaps.
+ *
+ *              Host encoders: tools/ssd1306_rle.py, tools/ssd1306_assets.py
+ * -------------------------------------------------------------------------------------+
+ * @usage       SSD1306_DrawBitmap_P (SSD1306_ADDR, 0, 0, LOGO);
+ */
+
+#ifndef __BITMAP_H__
+#define __BITMAP_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Bitmap formats
+  // ------------------------------------------------------------------------------------
+  #define BITMAP_RAW                0x00  // plain page data, width * pages bytes
+  #define BITMAP_RLE                0x01  // run length encoded page data
+  #define BITMAP_TILED              0x02  // tile indexes into shared tile set
+
+  // Tiles
+  // ------------------------------------------------------------------------------------
+  #define BITMAP_TILE_SIZE          8     // 8 columns x 1 page
+
+  // Bitmap header
+  // ------------------------------------------------------------------------------------
+  #define BITMAP_HEADER_SIZE        3
+  #define BITMAP_FORMAT             0     // offset of format
+  #define BITMAP_WIDTH              1     // offset of width in columns
+  #define BITMAP_PAGES              2     // offset of height in pages
+
+  // RLE tokens
+  // ------------------------------------------------------------------------------------
+  #define RLE_TYPE_MASK             0xC0
+  #define RLE_COUNT_MASK            0x3F
+  #define RLE_LITERAL               0x00  // literal bytes follow
+  #define RLE_RUN                   0x40  // repeated byte follows
+  #define RLE_ZEROS                 0x80  // run of 0x00
+  #define RLE_ONES                  0xC0  // run of 0xFF
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   SSD1306 Send raw data from flash into data stream
+   *
+   * @param   const uint8_t * data in PROGMEM
+   * @param   uint16_t number of bytes
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Raw_P (const uint8_t *, uint16_t);
+
+  /**
+   * @brief   SSD1306 Decode RLE tokens from flash into data stream
+   *
+   * @param   const uint8_t ** data in PROGMEM
+   * @param   uint16_t number of decoded bytes
+   *
+   * @return  uint8_t SSD1306_ERROR also for corrupted stream, bus is released
+   */
+  uint8_t SSD1306_Send_RLE_P (const uint8_t **, uint16_t);
+
+  /**
+   * @brief   SSD1306 Draw bitmap from flash directly to display
+   *
+   * @param   uint8_t address
+   * @param   uint8_t column
+   * @param   uint8_t page
+   * @param   const uint8_t * bitmap in PROGMEM
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_DrawBitmap_P (uint8_t, uint8_t, uint8_t, const uint8_t *);
+
+  /**
+   * @brief   SSD1306 Draw bitmap with shared tile set from flash directly to display
+   *
+   * @param   uint8_t address
+   * @param   uint8_t column
+   * @param   uint8_t page
+   * @param   const uint8_t * bitmap in PROGMEM
+   * @param   const uint8_t * tile set in PROGMEM
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_DrawBitmapTiled_P (uint8_t, uint8_t, uint8_t, const uint8_t *, const uint8_t *);
+
+#endif
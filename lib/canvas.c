@@ -0,0 +1,465 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Canvas - one drawing area over several panels
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        canvas.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      canvas.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Indicator walls of TWI & SPI modules drawn and flushed as one screen
+ */
+
+// @includes
+#include "canvas.h"
+
+#if SSD1306_USE_CANVAS
+
+// SPI stream of previous panel still running
+// ---------------------------------------------------------------------------------------
+#if defined(SPI_HARDWARE)
+  #define SSD1306_CANVAS_SPI_BUSY()     SPI_StreamBusy ()
+#else
+  #define SSD1306_CANVAS_SPI_BUSY()     0
+#endif
+
+// Panel of grid
+// ---------------------------------------------------------------------------------------
+typedef struct {
+  uint8_t address;                                                // TWI / SSD1306_SPI | CS
+  uint8_t * cache;                                                // CACHE_SIZE_MEM bytes
+  uint8_t page;                                                   // next page of flush
+  uint8_t retries;                                                // retries left in frame
+  uint8_t status;                                                 // status of last frame
+} SSD1306_Panel;
+
+// @var panels - row by row, left to right
+static SSD1306_Panel panels[SSD1306_PANELS];
+
+// @var text position - column may reach SSD1306_CANVAS_WIDTH
+static uint16_t canvasX;
+static uint8_t canvasPage;
+
+// @var flush in progress
+static uint8_t canvasFrame;
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Canvas byte - cache byte of canvas column & page
+ *
+ * @param   uint8_t x -> 0 ... SSD1306_CANVAS_WIDTH - 1
+ * @param   uint8_t page -> 0 ... SSD1306_CANVAS_PAGES - 1
+ *
+ * @return  uint8_t * NULL if out of canvas or panel not set
+ */
+static uint8_t * SSD1306_CanvasByte (uint8_t x, uint8_t page)
+{
+  uint8_t row = page / (END_PAGE_ADDR + 1);                       // panel row
+  uint8_t column = x >> 7;                                        // panel column (x / 128)
+  uint8_t * cache;
+
+  if ((row >= SSD1306_CANVAS_ROWS) || (column >= SSD1306_CANVAS_COLS)) {
+    return NULL;                                                  // out of range
+  }
+  cache = panels[row * SSD1306_CANVAS_COLS + column].cache;
+  if (NULL == cache) {
+    return NULL;                                                  // missing panel
+  }
+  page -= row * (END_PAGE_ADDR + 1);                              // page of panel
+
+  return &cache[(x & END_COLUMN_ADDR) + (page << 7)];
+}
+
+/**
+ * @brief   Canvas next panel to flush on given bus
+ *
+ * @param   uint8_t bus -> SSD1306_SPI or 0 (TWI)
+ *
+ * @return  uint8_t index, SSD1306_PANELS if none
+ */
+static uint8_t SSD1306_CanvasNext (uint8_t bus)
+{
+  uint8_t i = 0;
+
+  while (i < SSD1306_PANELS) {
+    if ((SSD1306_CANVAS_DONE != panels[i].page) && (bus == (panels[i].address & SSD1306_SPI))) {
+      break;
+    }
+    i++;
+  }
+
+  return i;
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Canvas set panel
+ *
+ * @param   uint8_t index -> row * SSD1306_CANVAS_COLS + column
+ * @param   uint8_t address -> TWI address or SSD1306_SPI | CS pin
+ * @param   uint8_t * cache of CACHE_SIZE_MEM bytes, NULL removes panel
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_CanvasPanel (uint8_t index, uint8_t address, uint8_t * cache)
+{
+  if (index >= SSD1306_PANELS) {
+    return SSD1306_ERROR;
+  }
+  panels[index].address = address;
+  panels[index].cache = cache;
+  panels[index].page = SSD1306_CANVAS_DONE;
+  panels[index].status = SSD1306_SUCCESS;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Canvas init all panels, every panel is tried
+ *
+ * @param   void
+ *
+ * @return  uint8_t first failed status, SSD1306_SUCCESS if all passed
+ */
+uint8_t SSD1306_CanvasInit (void)
+{
+  uint8_t status = SSD1306_SUCCESS;
+  uint8_t result;
+  uint8_t i;
+
+  for (i = 0; i < SSD1306_PANELS; i++) {
+    if (NULL == panels[i].cache) {
+      continue;
+    }
+    result = SSD1306_Init (panels[i].address);
+    panels[i].status = result;
+    if ((SSD1306_SUCCESS != result) && (SSD1306_SUCCESS == status)) {
+      status = result;
+    }
+  }
+
+  return status;
+}
+
+/**
+ * @brief   Canvas clear caches of all panels
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_CanvasClear (void)
+{
+  uint8_t i;
+
+  for (i = 0; i < SSD1306_PANELS; i++) {
+    if (panels[i].cache) {
+      memset (panels[i].cache, CLEAR_COLOR, CACHE_SIZE_MEM);
+      SSD1306_STATS_DRAW (CACHE_SIZE_MEM);
+    }
+  }
+}
+
+/**
+ * @brief   Canvas draw pixel
+ *
+ * @param   uint8_t x -> 0 ... SSD1306_CANVAS_WIDTH - 1
+ * @param   uint8_t y -> 0 ... SSD1306_CANVAS_HEIGHT - 1
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_CanvasDrawPixel (uint8_t x, uint8_t y)
+{
+  uint8_t * cache = SSD1306_CanvasByte (x, y >> 3);
+
+  if (NULL == cache) {
+    return SSD1306_ERROR;                                         // out of range
+  }
+  *cache |= 1 << (y & 0x07);                                      // y % 8
+  SSD1306_STATS_DRAW (1);
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Canvas draw line by Bresenham algoritm, seams are crossed pixel by pixel
+ *
+ * @param   uint8_t x start position
+ * @param   uint8_t x end position
+ * @param   uint8_t y start position
+ * @param   uint8_t y end position
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_CanvasDrawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
+{
+  int16_t D;                                                      // determinant
+  int16_t delta_x, delta_y;                                       // deltas
+  int16_t trace_x = 1, trace_y = 1;                               // steps
+
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_LINE);
+  delta_x = x2 - x1;                                              // delta x
+  delta_y = y2 - y1;                                              // delta y
+
+  if (delta_x < 0) {                                              // check if x2 > x1
+    delta_x = -delta_x;                                           // negate delta x
+    trace_x = -trace_x;                                           // negate step x
+  }
+
+  if (delta_y < 0) {                                              // check if y2 > y1
+    delta_y = -delta_y;                                           // negate detla y
+    trace_y = -trace_y;                                           // negate step y
+  }
+
+  // Bresenham condition for m < 1 (dy < dx)
+  // -------------------------------------------------------------------------------------
+  if (delta_y < delta_x) {
+    D = (delta_y << 1) - delta_x;                                 // calculate determinant
+    SSD1306_CanvasDrawPixel (x1, y1);                             // draw first pixel
+    while (x1 != x2) {                                            // check if x1 equal x2
+      x1 += trace_x;                                              // update x1
+      if (D >= 0) {                                               // check if determinant is positive
+        y1 += trace_y;                                            // update y1
+        D -= 2*delta_x;                                           // update determinant
+      }
+      D += 2*delta_y;                                             // update deteminant
+      SSD1306_CanvasDrawPixel (x1, y1);                           // draw next pixel
+    }
+  // for m > 1 (dy > dx)
+  // -------------------------------------------------------------------------------------
+  } else {
+    D = delta_y - (delta_x << 1);                                 // calculate determinant
+    SSD1306_CanvasDrawPixel (x1, y1);                             // draw first pixel
+    while (y1 != y2) {                                            // check if y2 equal y1
+      y1 += trace_y;                                              // update y1
+      if (D <= 0) {                                               // check if determinant is positive
+        x1 += trace_x;                                            // update y1
+        D += 2*delta_y;                                           // update determinant
+      }
+      D -= 2*delta_x;                                             // update deteminant
+      SSD1306_CanvasDrawPixel (x1, y1);                           // draw next pixel
+    }
+  }
+  SSD1306_PROBE_END (SSD1306_PROBE_LINE);
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Canvas set text position
+ *
+ * @param   uint8_t column -> 0 ... SSD1306_CANVAS_WIDTH - 1
+ * @param   uint8_t page -> 0 ... SSD1306_CANVAS_PAGES - 1
+ *
+ * @return  void
+ */
+void SSD1306_CanvasSetPosition (uint8_t x, uint8_t page)
+{
+  canvasX = x;
+  canvasPage = page;
+}
+
+/**
+ * @brief   Canvas draw character - character doesn't fit at the end of row goes to the
+ *          next row, panel is looked up again only when a seam is crossed
+ *
+ * @param   char character
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_CanvasDrawChar (char character)
+{
+  const uint8_t * font = FONTS[character-32];
+  uint8_t * cache;
+  uint8_t x;
+  uint8_t i = 0;
+
+  if ((canvasX + CHARS_COLS_LENGTH) > SSD1306_CANVAS_WIDTH) {     // next row
+    canvasX = 0;
+    canvasPage++;
+  }
+  if (canvasPage >= SSD1306_CANVAS_PAGES) {
+    return SSD1306_ERROR;                                         // out of range
+  }
+  x = canvasX;
+  cache = SSD1306_CanvasByte (x, canvasPage);
+  while (i < CHARS_COLS_LENGTH) {
+    if (i && !(x & END_COLUMN_ADDR)) {                            // seam
+      cache = SSD1306_CanvasByte (x, canvasPage);
+    }
+    if (cache) {
+      *cache++ = pgm_read_byte (&font[i]);
+    }
+    i++;
+    x++;
+  }
+  canvasX += CHARS_COLS_LENGTH + 1;
+  SSD1306_STATS_DRAW (CHARS_COLS_LENGTH);
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Canvas draw string
+ *
+ * @param   char * string
+ *
+ * @return  void
+ */
+void SSD1306_CanvasDrawString (char * str)
+{
+  int i = 0;
+
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_STRING);
+  while (str[i] != '\0') {
+    SSD1306_CanvasDrawChar (str[i++]);
+  }
+  SSD1306_PROBE_END (SSD1306_PROBE_STRING);
+}
+
+/**
+ * @brief   Canvas flush step - first call starts a frame of all panels. Whenever SPI
+ *          is free the next SPI panel is streamed by interrupt, TWI panels are sent
+ *          page by page in the foreground meanwhile; TWI transaction stays open over
+ *          pages and is closed only to start a stream or at the end of budget.
+ *          Failed TWI transfer is retried from the page not acknowledged, up to
+ *          SSD1306_RETRIES times per panel and frame. Caches must not be changed till
+ *          frame is complete.
+ *
+ * @param   uint16_t budget in bytes, TWI sends whole pages (SSD1306_CANVAS_PAGE_BYTES)
+ *
+ * @return  uint8_t SSD1306_STEP_PENDING, SSD1306_SUCCESS frame complete, else status
+ *                  of first failed panel
+ */
+uint8_t SSD1306_CanvasStep (uint16_t bytes)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t open = 0;                                               // TWI transaction
+  SSD1306_Panel * panel;
+  uint8_t i;
+
+  // frame start
+  // -------------------------------------------------------------------------------------
+  if (0 == canvasFrame) {
+    for (i = 0; i < SSD1306_PANELS; i++) {
+      if (panels[i].cache) {
+        panels[i].page = START_PAGE_ADDR;
+        panels[i].retries = SSD1306_RETRIES;
+        panels[i].status = SSD1306_SUCCESS;
+      }
+    }
+    canvasFrame = 1;
+  }
+  while (1) {
+    // SPI: next stream as soon as the previous one ends
+    // -----------------------------------------------------------------------------------
+    i = SSD1306_CanvasNext (SSD1306_SPI);
+    if ((i < SSD1306_PANELS) && !SSD1306_CANVAS_SPI_BUSY ()) {
+      if (open) {
+        SSD1306_Send_Stop ();                                     // transport is switched
+        open = 0;
+      }
+      panels[i].status = SSD1306_StreamBuffer (panels[i].address, panels[i].cache);
+      panels[i].page = SSD1306_CANVAS_DONE;
+      continue;
+    }
+    // TWI: next page within budget
+    // -----------------------------------------------------------------------------------
+    i = SSD1306_CanvasNext (0);
+    if ((i >= SSD1306_PANELS) || (bytes < (open ? (END_COLUMN_ADDR + 1) : SSD1306_CANVAS_PAGE_BYTES))) {
+      break;
+    }
+    panel = &panels[i];
+    if (0 == open) {
+      bytes -= SSD1306_STEP_OVERHEAD;
+      status = SSD1306_Send_StartAndSLAW (panel->address);
+      // retry - NOPs complete arguments of command interrupted by previous attempt
+      if ((SSD1306_SUCCESS == status) && (panel->retries < SSD1306_RETRIES)) {
+        status = SSD1306_Send_Command (SSD1306_NOP);
+        if (SSD1306_SUCCESS == status) {
+          status = SSD1306_Send_Command (SSD1306_NOP);
+        }
+      }
+      if (SSD1306_SUCCESS == status) {
+        status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, panel->page, END_PAGE_ADDR);
+      }
+      if (SSD1306_SUCCESS == status) {
+        status = SSD1306_Send_DataStream ();
+      }
+      open = (SSD1306_SUCCESS == status);
+    }
+    if (open) {
+      bytes -= END_COLUMN_ADDR + 1;
+      status = SSD1306_Send_Buffer (&panel->cache[panel->page << 7], END_COLUMN_ADDR + 1);
+      if (SSD1306_SUCCESS == status) {
+        if (++panel->page > END_PAGE_ADDR) {                      // panel complete
+          SSD1306_Send_Stop ();
+          panel->page = SSD1306_CANVAS_DONE;
+          open = 0;
+        }
+        continue;
+      }
+      open = 0;
+    }
+    // bus already released, retry from page not acked
+    // -----------------------------------------------------------------------------------
+    if (0 == panel->retries--) {
+      panel->status = status;
+      panel->page = SSD1306_CANVAS_DONE;
+    } else {
+      SSD1306_STATS_INC (retries);
+    }
+  }
+  if (open) {
+    SSD1306_Send_Stop ();
+  }
+  // frame complete when all panels are sent and the last stream ended
+  // -------------------------------------------------------------------------------------
+  if ((SSD1306_CanvasNext (0) < SSD1306_PANELS) ||
+      (SSD1306_CanvasNext (SSD1306_SPI) < SSD1306_PANELS) ||
+      SSD1306_CANVAS_SPI_BUSY ()) {
+    return SSD1306_STEP_PENDING;
+  }
+  canvasFrame = 0;
+  for (i = 0; i < SSD1306_PANELS; i++) {
+    if (panels[i].cache && (SSD1306_SUCCESS != panels[i].status)) {
+      return panels[i].status;
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Canvas flush all panels - blocking, both buses interleaved
+ *
+ * @param   void
+ *
+ * @return  uint8_t SSD1306_SUCCESS or status of first failed panel
+ */
+uint8_t SSD1306_CanvasUpdate (void)
+{
+  uint8_t status = INIT_STATUS;
+
+  while (SSD1306_STEP_PENDING == (status = SSD1306_CanvasStep (0xFFFF)));
+
+  return status;
+}
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Canvas - one drawing area over several panels
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        canvas.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Panels of compiled size (128 x MAX_Y) form a grid of SSD1306_CANVAS_COLS
+ *              x SSD1306_CANVAS_ROWS, panel index = row * SSD1306_CANVAS_COLS + column.
+ *              Every panel has own address (TWI or SSD1306_SPI | CS) and own cache of
+ *              CACHE_SIZE_MEM bytes given by application (SSD1306_CachePage (0) reuses
+ *              'cacheMemLcd'). Pixels, lines and text are drawn in canvas coordinates
+ *              across panel seams, missing panels are skipped.
+ *
+ *              Flush interleaves both buses: SPI panels are streamed by SPI interrupt
+ *              (SPI_STREAM) one after another, TWI panels are sent page by page in the
+ *              foreground meanwhile, so frame takes as long as the slower bus, not sum.
+ *
+ *              2 x 2 of 128x32 -> 256 x 64, 1 x 4 of 128x32 -> 128 x 128
+ * -------------------------------------------------------------------------------------+
+ * @usage       static uint8_t right[CACHE_SIZE_MEM];
+ *
+ *              SSD1306_CanvasPanel (0, SSD1306_ADDR, SSD1306_CachePage (0));
+ *              SSD1306_CanvasPanel (1, SSD1306_SPI | PB2, right);
+ *              SSD1306_CanvasInit ();
+ *              SSD1306_CanvasDrawLine (0, 255, 0, 31);
+ *              SSD1306_CanvasUpdate ();
+ */
+
+#ifndef __CANVAS_H__
+#define __CANVAS_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Grid of panels
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_CANVAS_COLS
+    #define SSD1306_CANVAS_COLS     2
+  #endif
+  #ifndef SSD1306_CANVAS_ROWS
+    #define SSD1306_CANVAS_ROWS     1
+  #endif
+  #define SSD1306_PANELS            (SSD1306_CANVAS_COLS * SSD1306_CANVAS_ROWS)
+
+  // Canvas size, coordinates are uint8_t
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_CANVAS_WIDTH      (SSD1306_CANVAS_COLS * (END_COLUMN_ADDR + 1))
+  #define SSD1306_CANVAS_PAGES      (SSD1306_CANVAS_ROWS * (END_PAGE_ADDR + 1))
+  #define SSD1306_CANVAS_HEIGHT     (SSD1306_CANVAS_PAGES << 3)
+
+  #if (SSD1306_CANVAS_WIDTH > 256) || (SSD1306_CANVAS_HEIGHT > 256)
+    #error "SSD1306 canvas larger than 256 x 256"
+  #endif
+
+  // Flush - bus bytes of one TWI page with re-addressing (SSD1306_CanvasStep budget),
+  // panel done in current frame
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_CANVAS_PAGE_BYTES ((END_COLUMN_ADDR + 1) + SSD1306_STEP_OVERHEAD)
+  #define SSD1306_CANVAS_DONE       0xFF
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Canvas set panel
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t *
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasPanel (uint8_t, uint8_t, uint8_t *);
+
+  /**
+   * @brief   Canvas init all panels
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasInit (void);
+
+  /**
+   * @brief   Canvas clear caches of all panels
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_CanvasClear (void);
+
+  /**
+   * @brief   Canvas draw pixel
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasDrawPixel (uint8_t, uint8_t);
+
+  /**
+   * @brief   Canvas draw line
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasDrawLine (uint8_t, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Canvas set text position
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  void
+   */
+  void SSD1306_CanvasSetPosition (uint8_t, uint8_t);
+
+  /**
+   * @brief   Canvas draw character
+   *
+   * @param   char
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasDrawChar (char);
+
+  /**
+   * @brief   Canvas draw string
+   *
+   * @param   char *
+   *
+   * @return  void
+   */
+  void SSD1306_CanvasDrawString (char *);
+
+  /**
+   * @brief   Canvas flush step within budget
+   *
+   * @param   uint16_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasStep (uint16_t);
+
+  /**
+   * @brief   Canvas flush all panels
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_CanvasUpdate (void);
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Build configuration - profiles & feature switches
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        config.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend
+ * -------------------------------------------------------------------------------------+
+ * @brief       Profile gives defaults of switches, every switch can be overridden by
+ *              -D (e.g. -DSSD1306_PROFILE=SSD1306_PROFILE_MINIMAL -DSSD1306_USE_GRAPHICS=1).
+ *              Disabled parts are not compiled; call of stripped primitive of ssd1306.h
+ *              fails at compile time (not declared), of stripped module at link time.
+ *
+ *              SSD1306_USE_TEXT      - SetPosition, DrawChar, DrawString, font
+ *              SSD1306_USE_GRAPHICS  - DrawPixel, DrawLine
+ *              SSD1306_USE_BITMAPS   - bitmap.c, animation.c, dither.c, grayscale.c
+ *              SSD1306_USE_SPI       - SPI panels on parts with hardware SPI
+ *              SSD1306_USE_ASYNC     - UpdateStep, UpdateShared, StreamBuffer,
+ *                                      StreamScreen, drawqueue.c
+ *              SSD1306_FONT          - font of text
+ *              SSD1306_INIT_TABLE    - init sequence
+ *
+ *              canvas.c needs text, graphics & async; drawqueue.c text & async.
+ *
+ *                         minimal   standard   full (default)
+ *              text          1         1          1
+ *              graphics      0         1          1
+ *              bitmaps       0         1          1
+ *              spi           0         1          1
+ *              async         0         0          1
+ * -------------------------------------------------------------------------------------+
+ * @usage       make minimal standard full DEVICE=atmega8
+ */
+
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+  // Profiles
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_PROFILE_MINIMAL   0     // text on TWI
+  #define SSD1306_PROFILE_STANDARD  1     // + graphics, bitmaps, SPI
+  #define SSD1306_PROFILE_FULL      2     // + non-blocking flush, canvas, draw queue
+
+  #ifndef SSD1306_PROFILE
+    #define SSD1306_PROFILE         SSD1306_PROFILE_FULL
+  #endif
+
+  // Fonts, SSD1306_FONT_DEFAULT is font.h
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_FONT_DEFAULT      0
+  #define SSD1306_FONT_5X8          1     // font5x8.h
+  #define SSD1306_FONT_6X8          2     // font6x8.h
+  #define SSD1306_FONT_8X8          3     // font8x8.h
+
+  // Init sequences
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_INIT_DATASHEET    0     // INIT_SSD1306
+  #define SSD1306_INIT_ADAFRUIT     1     // INIT_SSD1306_ADAFRUIT
+
+  // Feature switches
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_USE_TEXT
+    #define SSD1306_USE_TEXT        1
+  #endif
+  #ifndef SSD1306_USE_GRAPHICS
+    #define SSD1306_USE_GRAPHICS    (SSD1306_PROFILE >= SSD1306_PROFILE_STANDARD)
+  #endif
+  #ifndef SSD1306_USE_BITMAPS
+    #define SSD1306_USE_BITMAPS     (SSD1306_PROFILE >= SSD1306_PROFILE_STANDARD)
+  #endif
+  #ifndef SSD1306_USE_SPI
+    #define SSD1306_USE_SPI         (SSD1306_PROFILE >= SSD1306_PROFILE_STANDARD)
+  #endif
+  #ifndef SSD1306_USE_ASYNC
+    #define SSD1306_USE_ASYNC       (SSD1306_PROFILE >= SSD1306_PROFILE_FULL)
+  #endif
+  #ifndef SSD1306_FONT
+    #define SSD1306_FONT            SSD1306_FONT_DEFAULT
+  #endif
+  #ifndef SSD1306_INIT_TABLE
+    #define SSD1306_INIT_TABLE      SSD1306_INIT_DATASHEET
+  #endif
+
+  // Modules built on switched parts
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_USE_CANVAS        (SSD1306_USE_TEXT && SSD1306_USE_GRAPHICS && SSD1306_USE_ASYNC)
+  #define SSD1306_USE_DRAWQUEUE     (SSD1306_USE_TEXT && SSD1306_USE_ASYNC)
+
+#endif
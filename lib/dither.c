@@ -0,0 +1,178 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Dithering of grayscale sources
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        dither.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      dither.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Sensor thumbnails, grayscale pictures
+ */
+
+// @includes
+#include "dither.h"
+
+#if SSD1306_USE_BITMAPS
+
+// @const Bayer 8x8 threshold matrix, (index * 4 + 2)
+const uint8_t BAYER_8x8[8][8] PROGMEM = {
+  {   2, 130,  34, 162,  10, 138,  42, 170 },
+  { 194,  66, 226,  98, 202,  74, 234, 106 },
+  {  50, 178,  18, 146,  58, 186,  26, 154 },
+  { 242, 114, 210,  82, 250, 122, 218,  90 },
+  {  14, 142,  46, 174,   6, 134,  38, 166 },
+  { 206,  78, 238, 110, 198,  70, 230, 102 },
+  {  62, 190,  30, 158,  54, 182,  22, 150 },
+  { 254, 126, 222,  94, 246, 118, 214,  86 }
+};
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   SSD1306 Check dither area - landscape only, translated by viewport, inside
+ *          its clip
+ *
+ * @param   uint8_t * x
+ * @param   uint8_t * y
+ * @param   uint8_t width
+ * @param   uint8_t height
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_DitherArea (uint8_t * x, uint8_t * y, uint8_t width, uint8_t height)
+{
+  if (width > DITHER_MAX_WIDTH) {
+    return SSD1306_ERROR;
+  }
+  if (SSD1306_GetRotation () & SSD1306_PORTRAIT) {
+    return SSD1306_ERROR;                                         // landscape only
+  }
+
+  return SSD1306_ViewportArea (x, y, width, height);
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   SSD1306 Ordered dither (Bayer 8x8) into cache memory
+ *
+ * @param   uint8_t x -> 0 ... MAX_X
+ * @param   uint8_t y -> 0 ... MAX_Y
+ * @param   uint8_t width -> 1 ... DITHER_MAX_WIDTH
+ * @param   uint8_t height
+ * @param   SSD1306_GrayRow row reader
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_DitherBayer (uint8_t x, uint8_t y, uint8_t width, uint8_t height, SSD1306_GrayRow read)
+{
+  uint8_t gray[DITHER_MAX_WIDTH];
+  const uint8_t * threshold;
+  uint8_t * page;
+  uint8_t pixel;
+  uint8_t row;
+  uint8_t i;
+
+  if (SSD1306_SUCCESS != SSD1306_DitherArea (&x, &y, width, height)) {
+    return SSD1306_ERROR;
+  }
+  for (row = 0; row < height; row++, y++) {
+    read (row, gray, width);
+    page = SSD1306_CachePage (y >> 3);                            // find page (y / 8)
+    if (NULL == page) {
+      return SSD1306_ERROR;                                       // sparse pool exhausted
+    }
+    page += x;
+    pixel = 1 << (y & 0x07);                                      // which pixel (y % 8)
+    threshold = BAYER_8x8[y & 0x07];
+    for (i = 0; i < width; i++) {
+      if (gray[i] > pgm_read_byte (&threshold[(x + i) & 0x07])) {
+        page[i] |= pixel;
+      } else {
+        page[i] &= ~pixel;
+      }
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Error diffusion dither (Floyd-Steinberg) into cache memory
+ *          errors of next row are kept in one line, error to the right and to the
+ *          next row below/right are carried in registers
+ *
+ *                 X   7
+ *             3   5   1   (/16)
+ *
+ * @param   uint8_t x -> 0 ... MAX_X
+ * @param   uint8_t y -> 0 ... MAX_Y
+ * @param   uint8_t width -> 1 ... DITHER_MAX_WIDTH
+ * @param   uint8_t height
+ * @param   SSD1306_GrayRow row reader
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_DitherFloyd (uint8_t x, uint8_t y, uint8_t width, uint8_t height, SSD1306_GrayRow read)
+{
+  uint8_t gray[DITHER_MAX_WIDTH];
+  int16_t error[DITHER_MAX_WIDTH];                                // errors of current row
+  int16_t right;                                                  // error to x+1 this row
+  int16_t below_left;                                             // next row error at x-1
+  int16_t below;                                                  // next row error at x
+  int16_t value;
+  uint8_t * page;
+  uint8_t pixel;
+  uint8_t row;
+  uint8_t i;
+
+  if (SSD1306_SUCCESS != SSD1306_DitherArea (&x, &y, width, height)) {
+    return SSD1306_ERROR;
+  }
+  memset (error, 0, width * sizeof (int16_t));
+  for (row = 0; row < height; row++, y++) {
+    read (row, gray, width);
+    page = SSD1306_CachePage (y >> 3);                            // find page (y / 8)
+    if (NULL == page) {
+      return SSD1306_ERROR;                                       // sparse pool exhausted
+    }
+    page += x;
+    pixel = 1 << (y & 0x07);                                      // which pixel (y % 8)
+    right = below_left = below = 0;
+    for (i = 0; i < width; i++) {
+      value = gray[i] + error[i] + right;
+      if (value >= DITHER_THRESHOLD) {
+        page[i] |= pixel;
+        value -= DITHER_WHITE;                                    // error
+      } else {
+        page[i] &= ~pixel;
+      }
+      right = (value * 7) >> 4;
+      if (i) {
+        error[i - 1] = below_left + ((value * 3) >> 4);           // x-1 complete
+      }
+      below_left = below + ((value * 5) >> 4);
+      below = value >> 4;
+    }
+    error[width - 1] = below_left;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Dithering of grayscale sources
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        dither.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       8-bit grayscale rows are requested one by one through a callback and
+ *              written into 'cacheMemLcd' in page format, so no copy of the source image
+ *              is held in RAM:
+ *                - Bayer ordered dither, 8x8 threshold matrix in PROGMEM, no state
+ *                - Floyd-Steinberg, one line of errors (2 bytes per column)
+ *              Working RAM on stack is DITHER_MAX_WIDTH row bytes (+ errors).
+ * -------------------------------------------------------------------------------------+
+ * @usage       void row (uint8_t y, uint8_t * gray, uint8_t width) { ... }
+ *
+ *              SSD1306_DitherFloyd (0, 0, 48, 48, row);
+ *              SSD1306_UpdateScreen (SSD1306_ADDR);
+ */
+
+#ifndef __DITHER_H__
+#define __DITHER_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Maximal width of source image
+  // ------------------------------------------------------------------------------------
+  #ifndef DITHER_MAX_WIDTH
+    #define DITHER_MAX_WIDTH        64
+  #endif
+
+  // Threshold - white / black
+  // ------------------------------------------------------------------------------------
+  #define DITHER_WHITE              255
+  #define DITHER_THRESHOLD          128
+
+  // @type row reader - fill row y of source image (width bytes, 0 = black, 255 = white)
+  typedef void (*SSD1306_GrayRow) (uint8_t, uint8_t *, uint8_t);
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   SSD1306 Ordered dither (Bayer 8x8) into cache memory
+   *
+   * @param   uint8_t x
+   * @param   uint8_t y
+   * @param   uint8_t width
+   * @param   uint8_t height
+   * @param   SSD1306_GrayRow
+   *
+   * @return  uint8_t SSD1306_ERROR also in portrait rotation
+   */
+  uint8_t SSD1306_DitherBayer (uint8_t, uint8_t, uint8_t, uint8_t, SSD1306_GrayRow);
+
+  /**
+   * @brief   SSD1306 Error diffusion dither (Floyd-Steinberg) into cache memory
+   *
+   * @param   uint8_t x
+   * @param   uint8_t y
+   * @param   uint8_t width
+   * @param   uint8_t height
+   * @param   SSD1306_GrayRow
+   *
+   * @return  uint8_t SSD1306_ERROR also in portrait rotation
+   */
+  uint8_t SSD1306_DitherFloyd (uint8_t, uint8_t, uint8_t, uint8_t, SSD1306_GrayRow);
+
+#endif
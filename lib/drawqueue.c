@@ -0,0 +1,173 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Draw queue - UI updates posted from interrupts
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        drawqueue.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      drawqueue.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Encoder, ADC or timer values shown without drawing inside interrupts
+ */
+
+// @includes
+#include <util/atomic.h>
+#include "drawqueue.h"
+
+#if SSD1306_USE_DRAWQUEUE
+
+// @var latest values & dirty bits - value is stored before its bit is set
+static volatile uint16_t postValue[SSD1306_FIELDS_MAX];
+static volatile uint8_t postDirty;
+
+// @var field table, values to draw (consumer only)
+static const SSD1306_Field * drawqFields;
+static volatile uint8_t drawqFieldsCount;
+static uint16_t fieldValue[SSD1306_FIELDS_MAX];
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Draw queue draw field - digits from right, spaces on left, '#' if value
+ *          doesn't fit
+ *
+ * @param   uint8_t field
+ *
+ * @return  void
+ */
+static void SSD1306_DrawField (uint8_t field)
+{
+  const SSD1306_Field * table = &drawqFields[field];
+  uint8_t width = pgm_read_byte (&table->width);
+  uint8_t base = pgm_read_byte (&table->base);
+  uint16_t value = fieldValue[field];
+  char text[6];
+  uint8_t digit;
+  uint8_t i;
+
+  if (width > sizeof (text)) {
+    width = sizeof (text);
+  }
+  // right aligned digits
+  // -------------------------------------------------------------------------------------
+  i = width;
+  do {
+    digit = value % base;
+    text[--i] = digit < 10 ? '0' + digit : 'A' - 10 + digit;
+    value /= base;
+  } while (value && i);
+  while (i) {
+    text[--i] = ' ';
+  }
+  if (value) {
+    memset (text, '#', width);                                    // overflow
+  }
+  // draw
+  // -------------------------------------------------------------------------------------
+  SSD1306_SetPosition (pgm_read_byte (&table->x), pgm_read_byte (&table->page));
+  for (i = 0; i < width; i++) {
+    SSD1306_DrawChar (text[i]);
+  }
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Draw queue set field table
+ *
+ * @param   const SSD1306_Field * table in PROGMEM
+ * @param   uint8_t number of fields -> 1 ... SSD1306_FIELDS_MAX
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_FieldsInit (const SSD1306_Field * table, uint8_t count)
+{
+  if (count > SSD1306_FIELDS_MAX) {
+    return SSD1306_ERROR;
+  }
+  ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+    drawqFields = table;
+    drawqFieldsCount = count;
+    postDirty = 0;                                                // discard old commands
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Draw queue post value of field - called from interrupt (or from main loop
+ *          with interrupts posting disabled), value is stored before dirty bit is set,
+ *          pending value of the same field is overwritten (the latest wins)
+ *
+ * @param   uint8_t field
+ * @param   uint16_t value
+ *
+ * @return  uint8_t SSD1306_ERROR if field is out of table
+ */
+uint8_t SSD1306_Post (uint8_t field, uint16_t value)
+{
+  if (field >= drawqFieldsCount) {
+    return SSD1306_ERROR;
+  }
+  postValue[field] = value;
+  postDirty |= (1 << field);                                      // publish
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Draw queue drain - latest values & dirty mask are taken at once, then
+ *          every changed field is drawn once into cache memory, text position of
+ *          main loop is preserved
+ *
+ * @param   void
+ *
+ * @return  uint8_t number of drawn fields
+ */
+uint8_t SSD1306_DrainDraw (void)
+{
+  unsigned int counter = _counter;
+  uint8_t dirty;
+  uint8_t field;
+  uint8_t drawn = 0;
+
+  // take
+  // -------------------------------------------------------------------------------------
+  ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+    dirty = postDirty;
+    postDirty = 0;
+    for (field = 0; field < SSD1306_FIELDS_MAX; field++) {
+      if (dirty & (1 << field)) {
+        fieldValue[field] = postValue[field];
+      }
+    }
+  }
+  // draw
+  // -------------------------------------------------------------------------------------
+  for (field = 0; dirty; field++) {
+    if (dirty & (1 << field)) {
+      dirty &= ~(1 << field);
+      SSD1306_DrawField (field);
+      drawn++;
+    }
+  }
+  _counter = counter;
+
+  return drawn;
+}
+
+#endif
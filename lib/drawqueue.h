@@ -0,0 +1,90 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Draw queue - UI updates posted from interrupts
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        drawqueue.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Single producer / single consumer mailbox of draw commands. Interrupts
+ *              post (field, value) without touching 'cacheMemLcd' or '_counter', main
+ *              loop drains it into cache memory before flush. Every field has one
+ *              latest-value slot and one bit of dirty mask, a new post overwrites the
+ *              pending one, so nothing is ever dropped and a fast encoder doesn't
+ *              redraw each step.
+ *
+ *              Producer side is every ISR that posts - AVR interrupts don't nest (no
+ *              sei () inside handlers), so they are serialized and act as one producer.
+ *              Consumer takes slots & mask in one short atomic block.
+ *
+ *              Field: | column | page | width (characters) | base (10 / 16) |
+ * -------------------------------------------------------------------------------------+
+ * @usage       const SSD1306_Field FIELDS[] PROGMEM = { { 0, 0, 5, 10 }, { 64, 0, 4, 16 } };
+ *
+ *              SSD1306_FieldsInit (FIELDS, 2);
+ *              ISR (ADC_vect) { SSD1306_Post (0, ADC); }
+ *              while (1) { SSD1306_DrainDraw (); SSD1306_UpdateScreen (SSD1306_ADDR); }
+ */
+
+#ifndef __DRAWQUEUE_H__
+#define __DRAWQUEUE_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Fields - up to 8, collapsed by dirty bit mask
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_FIELDS_MAX        8
+
+  // Field placement
+  // ------------------------------------------------------------------------------------
+  typedef struct {
+    uint8_t x;                            // column of first character
+    uint8_t page;                         // page
+    uint8_t width;                        // characters, right aligned, space padded
+    uint8_t base;                         // 10 or 16
+  } SSD1306_Field;
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Draw queue set field table
+   *
+   * @param   const SSD1306_Field * table in PROGMEM
+   * @param   uint8_t number of fields
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_FieldsInit (const SSD1306_Field *, uint8_t);
+
+  /**
+   * @brief   Draw queue post value of field, interrupt side
+   *
+   * @param   uint8_t field
+   * @param   uint16_t value
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Post (uint8_t, uint16_t);
+
+  /**
+   * @brief   Draw queue drain into cache memory, main loop side
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_DrainDraw (void);
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Font of text - the only definition of font selected by
+ *              SSD1306_FONT, other files see extern declaration of the header
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        font.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      config.h, font.h, font5x8.h, font6x8.h, font8x8.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Another font in application - one .c file defines it:
+ *                #define SSD1306_FONT_DATA
+ *                #include "font8x8.h"
+ */
+
+// @includes
+#include "config.h"
+
+#if SSD1306_USE_TEXT
+
+#define SSD1306_FONT_DATA
+
+#if (SSD1306_FONT == SSD1306_FONT_5X8)
+  #include "font5x8.h"
+#elif (SSD1306_FONT == SSD1306_FONT_6X8)
+  #include "font6x8.h"
+#elif (SSD1306_FONT == SSD1306_FONT_8X8)
+  #include "font8x8.h"
+#else
+  #include "font.h"
+#endif
+
+#endif
@@ -32,7 +32,9 @@
   #define CHARS_COLS_LENGTH  5
 
   // @const Characters
-  static const uint8_t FONTS[][CHARS_COLS_LENGTH] PROGMEM = {
+  // defined once by file including this with SSD1306_FONT_DATA (lib/font.c)
+  #if defined(SSD1306_FONT_DATA)
+  const uint8_t FONTS[][CHARS_COLS_LENGTH] PROGMEM = {
     { 0x00, 0x00, 0x00, 0x00, 0x00 }, // 20 space
     { 0x81, 0x81, 0x18, 0x81, 0x81 }, // 21 !
     { 0x00, 0x07, 0x00, 0x07, 0x00 }, // 22 "
@@ -130,5 +132,8 @@
     { 0x10, 0x08, 0x08, 0x10, 0x08 }, // 7e ~
     { 0x00, 0x00, 0x00, 0x00, 0x00 }  // 7f
   };
+  #else
+  extern const uint8_t FONTS[][CHARS_COLS_LENGTH] PROGMEM;
+  #endif
 
 #endif
@@ -29,11 +29,13 @@
   // Characters definition
   // -----------------------------------
   // number of columns for chars
-  #define CHARS_COLS_LENGTH  6
+  #define FONTS_6X8_COLS  6
 
   // @author basti79
   // @source https://github.com/basti79/LCD-fonts/blob/master/6x8_vertikal_LSB_1.h
-  static const uint8_t FONTS[][CHARS_COLS_LENGTH] PROGMEM = {
+  // defined once by file including this with SSD1306_FONT_DATA (lib/font.c)
+  #if defined(SSD1306_FONT_DATA)
+  const uint8_t FONTS_6X8[][FONTS_6X8_COLS] PROGMEM = {
     {0x00,0x00,0x00,0x00,0x00,0x00},	// 0x20
     {0x00,0x00,0x06,0x5F,0x06,0x00},	// 0x21
     {0x00,0x07,0x03,0x00,0x07,0x03},	// 0x22
@@ -131,5 +133,8 @@
     {0x00,0x02,0x01,0x02,0x01,0x00},	// 0x7E
     {0x00,0x3C,0x26,0x23,0x26,0x3C},	// 0x7F
   };
+  #else
+  extern const uint8_t FONTS_6X8[][FONTS_6X8_COLS] PROGMEM;
+  #endif
 
 #endif
@@ -29,11 +29,13 @@
   // Characters definition
   // -----------------------------------
   // number of columns for chars
-  #define CHARS_COLS_LENGTH  8
+  #define FONTS_8X8_COLS  8
 
   // @author basti79
   // @source https://github.com/basti79/LCD-fonts/blob/master/8x8_vertikal_LSB_1.h
-  static const uint8_t FONTS[][CHARS_COLS_LENGTH] PROGMEM = {
+  // defined once by file including this with SSD1306_FONT_DATA (lib/font.c)
+  #if defined(SSD1306_FONT_DATA)
+  const uint8_t FONTS_8X8[][FONTS_8X8_COLS] PROGMEM = {
     {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},	// 0x20
     {0x00,0x06,0x5F,0x5F,0x06,0x00,0x00,0x00},	// 0x21
     {0x00,0x07,0x07,0x00,0x07,0x07,0x00,0x00},	// 0x22
@@ -131,5 +133,8 @@
     {0x02,0x03,0x01,0x03,0x02,0x03,0x01,0x00},	// 0x7E
     {0x78,0x7C,0x46,0x43,0x46,0x7C,0x78,0x00},	// 0x7F
   };
+  #else
+  extern const uint8_t FONTS_8X8[][FONTS_8X8_COLS] PROGMEM;
+  #endif
 
 #endif
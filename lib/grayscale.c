@@ -0,0 +1,284 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Temporal grayscale (frame rate control)
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        grayscale.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      grayscale.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       4 level grayscale UI elements
+ */
+
+// @includes
+#include "grayscale.h"
+
+#if SSD1306_USE_BITMAPS
+
+// @var ticks incremented by SSD1306_GrayTick
+volatile uint8_t _grayTicks;
+
+// @var plane B (LSB) given by application, plane A (MSB) is cacheMemLcd
+static uint8_t * grayPlane;
+
+// @var plane A taken at init, CachePage would return layer buffer after LayerBegin
+static uint8_t * grayCache;
+
+// @var pattern position 0 ... GRAY_CYCLE-1
+static uint8_t grayPhase;
+
+// @var ticks already handled
+static uint8_t grayHandled;
+
+// @var window to be set again, address pointer lost by failed transfer
+static uint8_t grayResync;
+
+// @var measurement - flushes & ticks in current window, rate of last window
+static uint16_t grayFrames;
+static uint16_t grayWindow;
+static uint16_t grayRate;
+static uint16_t grayMissed;
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Grayscale flush plane - window is already set, address pointer wraps back
+ *          to the first column and page after the last byte; after failure the window
+ *          is sent again
+ *
+ * @param   uint8_t address
+ * @param   const uint8_t * plane
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_GrayFlush (uint8_t address, const uint8_t * plane)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t resync = grayResync;
+
+  grayResync = 1;                                                 // till plane is acknowledged
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // deferred commands, window stays unless lost
+  // -------------------------------------------------------------------------------------
+  if (resync) {
+    status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, START_PAGE_ADDR, END_PAGE_ADDR);
+  } else {
+    status = SSD1306_Send_Queue ();
+  }
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // control byte data stream
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_DataStream ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // plane
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Buffer (plane, CACHE_SIZE_MEM);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+  grayResync = 0;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Grayscale init - clear planes & set full screen window, on failure the
+ *          window is set by the first flush; not available with sparse cache
+ *          (SSD1306_SPARSE), call outside of SSD1306_LayerBegin ... LayerEnd
+ *
+ * @param   uint8_t address
+ * @param   uint8_t * plane B, CACHE_SIZE_MEM bytes
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_GrayInit (uint8_t address, uint8_t * plane)
+{
+#if defined(SSD1306_SPARSE)
+  (void) address;
+  (void) plane;
+
+  return SSD1306_ERROR;                                           // plane A not contiguous
+#else
+  uint8_t status = INIT_STATUS;
+
+  grayPlane = plane;
+  grayCache = SSD1306_CachePage (0);
+  SSD1306_GrayClear ();
+  grayPhase = 0;
+  grayHandled = _grayTicks;
+  grayFrames = grayWindow = grayRate = grayMissed = 0;
+  grayResync = 1;
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // window
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, START_PAGE_ADDR, END_PAGE_ADDR);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+  grayResync = 0;
+
+  return SSD1306_SUCCESS;
+#endif
+}
+
+/**
+ * @brief   Grayscale clear both planes
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_GrayClear (void)
+{
+  SSD1306_ClearScreen ();                                         // plane A
+  memset (grayPlane, 0x00, CACHE_SIZE_MEM);                       // plane B
+}
+
+/**
+ * @brief   Grayscale draw pixel
+ *
+ * @param   uint8_t x -> 0 ... MAX_X
+ * @param   uint8_t y -> 0 ... MAX_Y
+ * @param   uint8_t level -> GRAY_BLACK ... GRAY_WHITE
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_GrayPixel (uint8_t x, uint8_t y, uint8_t level)
+{
+  return SSD1306_GrayFill (x, y, 1, 1, level);
+}
+
+/**
+ * @brief   Grayscale fill rectangle
+ *
+ * @param   uint8_t x -> 0 ... MAX_X
+ * @param   uint8_t y -> 0 ... MAX_Y
+ * @param   uint8_t width
+ * @param   uint8_t height
+ * @param   uint8_t level -> GRAY_BLACK ... GRAY_WHITE
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_GrayFill (uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t level)
+{
+  uint8_t * a;
+  uint8_t * b;
+  uint8_t pixel;
+  uint8_t i;
+
+  if (SSD1306_GetRotation () & SSD1306_PORTRAIT) {
+    return SSD1306_ERROR;                                         // landscape only
+  }
+  if ((SSD1306_SUCCESS != SSD1306_ViewportArea (&x, &y, width, height)) || (level > GRAY_WHITE)) {
+    return SSD1306_ERROR;                                         // outside viewport
+  }
+  while (height--) {
+    a = grayCache + ((y >> 3) << 7) + x;                          // page (y / 8)
+    b = grayPlane + ((y >> 3) << 7) + x;
+    pixel = 1 << (y & 0x07);                                      // which pixel (y % 8)
+    for (i = 0; i < width; i++) {
+      a[i] = (level & 0x02) ? (a[i] | pixel) : (a[i] & ~pixel);
+      b[i] = (level & 0x01) ? (b[i] | pixel) : (b[i] & ~pixel);
+    }
+    y++;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Grayscale update - flush next plane of pattern A, A, B if tick is pending
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_GrayUpdate (uint8_t address)
+{
+  uint8_t pending = _grayTicks - grayHandled;
+  uint8_t status;
+
+  if (0 == pending) {
+    return GRAY_IDLE;
+  }
+  grayHandled += pending;
+  grayMissed += pending - 1;                                      // flush slower than tick
+  grayWindow += pending;
+  // flush
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_GrayFlush (address, (grayPhase < (GRAY_CYCLE - 1)) ? grayCache : grayPlane);
+  if (++grayPhase == GRAY_CYCLE) {
+    grayPhase = 0;
+  }
+  grayFrames++;
+  // refresh rate measured over one second of ticks
+  // -------------------------------------------------------------------------------------
+  if (grayWindow >= GRAY_TICK_HZ) {
+    grayRate = ((uint32_t) grayFrames * GRAY_TICK_HZ) / grayWindow;
+    grayFrames = grayWindow = 0;
+  }
+
+  return status;
+}
+
+/**
+ * @brief   Grayscale achieved refresh rate, plane flushes per second
+ *
+ * @param   void
+ *
+ * @return  uint16_t
+ */
+uint16_t SSD1306_GrayRefreshRate (void)
+{
+  return grayRate;
+}
+
+/**
+ * @brief   Grayscale ticks missed because flush was slower than tick
+ *
+ * @param   void
+ *
+ * @return  uint16_t
+ */
+uint16_t SSD1306_GrayMissedTicks (void)
+{
+  return grayMissed;
+}
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Temporal grayscale (frame rate control)
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        grayscale.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       4 gray levels from 2 bitplanes flushed in weighted pattern:
+ *                plane A (MSB) = 'cacheMemLcd', shown 2 of 3 frames
+ *                plane B (LSB) = application buffer of CACHE_SIZE_MEM bytes,
+ *                                shown 1 of 3 frames
+ *              level = 2*A + B, pixel is lit for level/3 of time.
+ *
+ *              Window is set by SSD1306_GrayInit, every flush is then only START,
+ *              SLA+W, one data control byte and the plane. Failed flush leaves the
+ *              address pointer in the middle of the plane, the next one sets the
+ *              window again. Nothing else may change the window while the mode is
+ *              running. Use the highest TWI clock the panel accepts,
+ *              SSD1306_GrayRefreshRate tells if it is enough (~150 flushes/s and more
+ *              look steady, 400 kHz carries ~85 planes of 128x32 per second).
+ * -------------------------------------------------------------------------------------+
+ * @usage       ISR (TIMER2_COMPA_vect) { SSD1306_GrayTick (); }      // GRAY_TICK_HZ
+ *
+ *              static uint8_t plane[CACHE_SIZE_MEM];
+ *              SSD1306_GrayInit (SSD1306_ADDR, plane);
+ *              SSD1306_GrayPixel (10, 10, GRAY_LIGHT);
+ *              while (1) { SSD1306_GrayUpdate (SSD1306_ADDR); ... }
+ */
+
+#ifndef __GRAYSCALE_H__
+#define __GRAYSCALE_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Frequency of SSD1306_GrayTick calls - default is what the bus carries, one plane
+  //   = (CACHE_SIZE_MEM + 4) bytes * 9 bits, rounded to 10 bits as margin for START,
+  //   STOP & gaps between bytes (400 kHz: 77 Hz for 128x32, 38 Hz for 128x64)
+  // ------------------------------------------------------------------------------------
+  #ifndef GRAY_TICK_HZ
+    #define GRAY_TICK_HZ            (TWI_SCL_FREQ / ((CACHE_SIZE_MEM + 4) * 10UL))
+  #endif
+
+  // Gray levels
+  // ------------------------------------------------------------------------------------
+  #define GRAY_BLACK                0
+  #define GRAY_DARK                 1     // 1/3
+  #define GRAY_LIGHT                2     // 2/3
+  #define GRAY_WHITE                3
+
+  // Pattern of planes in one cycle - A, A, B
+  // ------------------------------------------------------------------------------------
+  #define GRAY_CYCLE                3
+
+  // Update status
+  // ------------------------------------------------------------------------------------
+  #define GRAY_IDLE                 2     // no tick pending
+
+  // @var ticks incremented by SSD1306_GrayTick
+  extern volatile uint8_t _grayTicks;
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Grayscale tick, call from timer interrupt with GRAY_TICK_HZ
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  static inline void SSD1306_GrayTick (void) { _grayTicks++; }
+
+  /**
+   * @brief   Grayscale init - clear planes & set window
+   *
+   * @param   uint8_t address
+   * @param   uint8_t * plane B
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_GrayInit (uint8_t, uint8_t *);
+
+  /**
+   * @brief   Grayscale clear both planes
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_GrayClear (void);
+
+  /**
+   * @brief   Grayscale draw pixel
+   *
+   * @param   uint8_t x
+   * @param   uint8_t y
+   * @param   uint8_t level
+   *
+   * @return  uint8_t SSD1306_ERROR also in portrait rotation
+   */
+  uint8_t SSD1306_GrayPixel (uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Grayscale fill rectangle
+   *
+   * @param   uint8_t x
+   * @param   uint8_t y
+   * @param   uint8_t width
+   * @param   uint8_t height
+   * @param   uint8_t level
+   *
+   * @return  uint8_t SSD1306_ERROR also in portrait rotation
+   */
+  uint8_t SSD1306_GrayFill (uint8_t, uint8_t, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Grayscale update - flush next plane of pattern if tick is pending
+   *
+   * @param   uint8_t address
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_GrayUpdate (uint8_t);
+
+  /**
+   * @brief   Grayscale achieved refresh rate, flushes in last second
+   *
+   * @param   void
+   *
+   * @return  uint16_t
+   */
+  uint16_t SSD1306_GrayRefreshRate (void);
+
+  /**
+   * @brief   Grayscale ticks missed because flush was slower than tick
+   *
+   * @param   void
+   *
+   * @return  uint16_t
+   */
+  uint16_t SSD1306_GrayMissedTicks (void);
+
+#endif
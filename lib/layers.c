@@ -0,0 +1,304 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Layers - page compositor of independent layers
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        layers.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      layers.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Status bar refreshed every second over content changed on user input
+ */
+
+// @includes
+#include "layers.h"
+
+#if defined(SSD1306_LAYERS)
+
+// Layer
+// ---------------------------------------------------------------------------------------
+typedef struct {
+  uint8_t * buffer;                                               // pages * 128 bytes
+  uint8_t page;                                                   // screen page of page 0
+  uint8_t pages;                                                  // number of pages
+  uint8_t x;                                                      // column offset
+  uint8_t mode;                                                   // SSD1306_LAYER_COPY ...
+  uint8_t visible;
+  uint8_t dirty;                                                  // changed since flush
+} SSD1306_Layer;
+
+// @var layers - bottom up
+static SSD1306_Layer layers[SSD1306_LAYER_COUNT];
+
+// @var screen pages to composite besides areas of dirty layers, bit per page,
+//      all after reset (display RAM unknown)
+static uint8_t layerPages = 0xFF;
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PRIVATE FUNCTIONS ===============================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Layer area - screen pages covered by layer
+ *
+ * @param   const SSD1306_Layer * layer
+ *
+ * @return  uint8_t bit per page
+ */
+static uint8_t SSD1306_LayerArea (const SSD1306_Layer * layer)
+{
+  return (uint8_t) (((1 << layer->pages) - 1) << layer->page);
+}
+
+/**
+ * @brief   Layers page - composites one screen page column by column and sends it,
+ *          window & data stream already set
+ *
+ * @param   uint8_t page -> 0 ... END_PAGE_ADDR
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_LayersPage (uint8_t page)
+{
+  uint8_t status = INIT_STATUS;
+  const SSD1306_Layer * layer = layers;
+  const uint8_t * rows[SSD1306_LAYER_COUNT];
+  uint8_t offset[SSD1306_LAYER_COUNT];
+  uint8_t mode[SSD1306_LAYER_COUNT];
+  uint8_t count = 0;
+  uint8_t column;
+  uint8_t data;
+  uint8_t byte;
+  uint8_t i;
+
+  // visible layers over page, looked up once per page
+  // -------------------------------------------------------------------------------------
+  for (i = 0; i < SSD1306_LAYER_COUNT; i++, layer++) {
+    if (layer->buffer && layer->visible &&
+       (page >= layer->page) && (page < (layer->page + layer->pages))) {
+      rows[count] = layer->buffer + ((page - layer->page) << 7);  // page of layer * 128
+      offset[count] = layer->x;
+      mode[count] = layer->mode;
+      count++;
+    }
+  }
+  // composite on the way to the bus
+  // -------------------------------------------------------------------------------------
+  for (column = START_COLUMN_ADDR; column <= END_COLUMN_ADDR; column++) {
+    data = CLEAR_COLOR;
+    for (i = 0; i < count; i++) {
+      byte = rows[i][(column - offset[i]) & END_COLUMN_ADDR];     // offset wraps around
+      if (SSD1306_LAYER_XOR == mode[i]) {
+        data ^= byte;
+      } else if (SSD1306_LAYER_OR == mode[i]) {
+        data |= byte;
+      } else {
+        data = byte;
+      }
+    }
+    status = SSD1306_Send_Data (data);
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   Layer set - buffer, position & mode, layer is visible, column offset 0
+ *
+ * @param   uint8_t index -> 0 ... SSD1306_LAYER_COUNT - 1
+ * @param   uint8_t * buffer of pages * 128 bytes, NULL removes layer
+ * @param   uint8_t screen page of first page
+ * @param   uint8_t number of pages
+ * @param   uint8_t mode -> SSD1306_LAYER_COPY, SSD1306_LAYER_OR, SSD1306_LAYER_XOR
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_LayerSet (uint8_t index, uint8_t * buffer, uint8_t page, uint8_t pages, uint8_t mode)
+{
+  SSD1306_Layer * layer = &layers[index];
+
+  if ((index >= SSD1306_LAYER_COUNT) || (0 == pages) ||
+     ((page + pages) > (END_PAGE_ADDR + 1)) || (mode > SSD1306_LAYER_XOR)) {
+    return SSD1306_ERROR;
+  }
+  if (layer->buffer) {
+    layerPages |= SSD1306_LayerArea (layer);                      // old area
+  }
+  layer->buffer = buffer;
+  layer->page = page;
+  layer->pages = pages;
+  layer->x = 0;
+  layer->mode = mode;
+  layer->visible = 1;
+  layer->dirty = 1;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Layer begin - library primitives draw into layer, coordinates local to
+ *          layer, SSD1306_ClearScreen clears layer; layer is marked dirty
+ *
+ * @param   uint8_t index
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_LayerBegin (uint8_t index)
+{
+  if ((index >= SSD1306_LAYER_COUNT) || (NULL == layers[index].buffer)) {
+    return SSD1306_ERROR;
+  }
+  layers[index].dirty = 1;
+  SSD1306_CacheTarget (layers[index].buffer, layers[index].pages);
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Layer end - primitives draw into cache memory again
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_LayerEnd (void)
+{
+  SSD1306_CacheTarget (NULL, 0);
+}
+
+/**
+ * @brief   Layer show / hide
+ *
+ * @param   uint8_t index
+ * @param   uint8_t visible -> 0 hidden, 1 visible
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_LayerShow (uint8_t index, uint8_t visible)
+{
+  if (index >= SSD1306_LAYER_COUNT) {
+    return SSD1306_ERROR;
+  }
+  if (layers[index].visible != visible) {
+    layers[index].visible = visible;
+    layers[index].dirty = 1;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Layer move - column offset (wraps around) & screen page
+ *
+ * @param   uint8_t index
+ * @param   uint8_t x -> 0 ... 127
+ * @param   uint8_t screen page of first page
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_LayerMove (uint8_t index, uint8_t x, uint8_t page)
+{
+  SSD1306_Layer * layer = &layers[index];
+
+  if ((index >= SSD1306_LAYER_COUNT) || ((page + layer->pages) > (END_PAGE_ADDR + 1))) {
+    return SSD1306_ERROR;
+  }
+  if ((layer->x != x) || (layer->page != page)) {
+    layerPages |= SSD1306_LayerArea (layer);                      // old area
+    layer->x = x & END_COLUMN_ADDR;
+    layer->page = page;
+    layer->dirty = 1;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   Layers update - composites & sends only pages under changed layers,
+ *          consecutive pages in one transaction; on failure changes are kept and
+ *          sent by next call
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_LayersUpdate (uint8_t address)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t pages = layerPages;
+  uint8_t page = START_PAGE_ADDR;
+  uint8_t last;
+  uint8_t i;
+
+  for (i = 0; i < SSD1306_LAYER_COUNT; i++) {
+    if (layers[i].dirty) {
+      pages |= SSD1306_LayerArea (&layers[i]);
+    }
+  }
+  while (page <= END_PAGE_ADDR) {
+    if (!(pages & (1 << page))) {
+      page++;
+      continue;
+    }
+    last = page;
+    while ((last < END_PAGE_ADDR) && (pages & (1 << (last + 1)))) {
+      last++;
+    }
+    // TWI: start & SLAW
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_StartAndSLAW (address);
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+    // window of changed pages
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, page, last);
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+    // control byte data stream
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_DataStream ();
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+    // composite page by page
+    // -----------------------------------------------------------------------------------
+    while (page <= last) {
+      status = SSD1306_LayersPage (page++);
+      if (SSD1306_SUCCESS != status) {
+        return status;
+      }
+    }
+    // stop TWI
+    // -----------------------------------------------------------------------------------
+    SSD1306_Send_Stop ();
+  }
+  // display is up to date
+  // -------------------------------------------------------------------------------------
+  layerPages = 0;
+  for (i = 0; i < SSD1306_LAYER_COUNT; i++) {
+    layers[i].dirty = 0;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Layers - page compositor of independent layers
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        layers.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Compiled with -DSSD1306_LAYERS. Every layer has own buffer of full width
+ *              pages given by application, screen page of its first page, column offset
+ *              (wraps around, for tickers), mode of compositing and visibility. Layers
+ *              are drawn by the library primitives between SSD1306_LayerBegin and
+ *              SSD1306_LayerEnd, coordinates are local to layer.
+ *
+ *              Flush composites layers bottom up (index 0 first) column by column
+ *              while the bytes go to the bus, no screen sized buffer is needed. Only
+ *              pages under layers changed since the last flush (drawn, moved, shown or
+ *              hidden) are composited and sent.
+ * -------------------------------------------------------------------------------------+
+ * @usage       static uint8_t bar[128];
+ *              static uint8_t content[3 * 128];
+ *
+ *              SSD1306_LayerSet (0, content, 1, 3, SSD1306_LAYER_COPY);
+ *              SSD1306_LayerSet (1, bar, 0, 1, SSD1306_LAYER_COPY);
+ *              SSD1306_LayerBegin (1);
+ *              SSD1306_ClearScreen ();
+ *              SSD1306_SetPosition (0, 0);
+ *              SSD1306_DrawString ("12:45");
+ *              SSD1306_LayerEnd ();
+ *              SSD1306_LayersUpdate (SSD1306_ADDR);
+ */
+
+#ifndef __LAYERS_H__
+#define __LAYERS_H__
+
+  // @includes
+  #include "ssd1306.h"
+
+  // Number of layers
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_LAYER_COUNT
+    #define SSD1306_LAYER_COUNT     3
+  #endif
+
+  #if (END_PAGE_ADDR > 7)
+    #error "SSD1306 layers support at most 8 pages"
+  #endif
+
+  // Modes of compositing with layers below
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_LAYER_COPY        0     // overwrite
+  #define SSD1306_LAYER_OR          1
+  #define SSD1306_LAYER_XOR         2
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Layer set buffer, position & mode
+   *
+   * @param   uint8_t
+   * @param   uint8_t *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_LayerSet (uint8_t, uint8_t *, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Layer begin drawing
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_LayerBegin (uint8_t);
+
+  /**
+   * @brief   Layer end drawing
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_LayerEnd (void);
+
+  /**
+   * @brief   Layer show / hide
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_LayerShow (uint8_t, uint8_t);
+
+  /**
+   * @brief   Layer move
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_LayerMove (uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   Layers flush changed pages
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_LayersUpdate (uint8_t);
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Timeline probes
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        probe.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      avr/io.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Compiled in by -DSSD1306_PROBE, empty macros otherwise. Every probe is
+ *              one bit of SSD1306_PROBE_REG set at begin and cleared at end of traced
+ *              code (single sbi / cbi, 2 cycles). Default register is GPIOR0 read by
+ *              simavr harness tools/ssd1306_vcd.c, a port (e.g. -DSSD1306_PROBE_REG=PORTD
+ *              -DSSD1306_PROBE_DDR=DDRD) shows the same timeline on logic analyzer.
+ *              Parts without GPIOR0 (Atmega8 / Atmega16) need the register given,
+ *              harness then gets its data space address (-r). Bits 6 - 7 belong to
+ *              application and are never touched by the library.
+ *
+ *              bit 0 - SSD1306_Init          bit 4 - bus transaction (START ... STOP)
+ *              bit 1 - update screen         bit 5 - TWI wait for TWINT
+ *              bit 2 - SSD1306_DrawString    bit 6 - application
+ *              bit 3 - SSD1306_DrawLine      bit 7 - application
+ * -------------------------------------------------------------------------------------+
+ * @usage       SSD1306_PROBE_BEGIN (SSD1306_PROBE_APP0);
+ *              control ();
+ *              SSD1306_PROBE_END (SSD1306_PROBE_APP0);
+ */
+
+#ifndef __PROBE_H__
+#define __PROBE_H__
+
+  // @includes
+  #include <avr/io.h>
+
+  // Probe bits
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_PROBE_INIT        0
+  #define SSD1306_PROBE_UPDATE      1
+  #define SSD1306_PROBE_STRING      2
+  #define SSD1306_PROBE_LINE        3
+  #define SSD1306_PROBE_BUS         4
+  #define SSD1306_PROBE_WAIT        5
+  #define SSD1306_PROBE_APP0        6
+  #define SSD1306_PROBE_APP1        7
+
+  // Bits of library - 0 ... 5
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_PROBE_MASK        0x3F
+
+  #if defined(SSD1306_PROBE)
+
+  // Debug register
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_PROBE_REG
+    #if defined(GPIOR0)
+      #define SSD1306_PROBE_REG     GPIOR0
+    #else
+      #error "No GPIOR0 on this part, set SSD1306_PROBE_REG (e.g. -DSSD1306_PROBE_REG=PORTD -DSSD1306_PROBE_DDR=DDRD)"
+    #endif
+  #endif
+
+  // Hooks - setup clears / drives library bits only
+  // ------------------------------------------------------------------------------------
+  #if defined(SSD1306_PROBE_DDR)
+    #define SSD1306_PROBE_SETUP()           { SSD1306_PROBE_DDR |= SSD1306_PROBE_MASK; SSD1306_PROBE_REG &= ~SSD1306_PROBE_MASK; }
+  #else
+    #define SSD1306_PROBE_SETUP()           { SSD1306_PROBE_REG &= ~SSD1306_PROBE_MASK; }
+  #endif
+  #define SSD1306_PROBE_BEGIN(BIT)          { SSD1306_PROBE_REG |= (1 << (BIT)); }
+  #define SSD1306_PROBE_END(BIT)            { SSD1306_PROBE_REG &= ~(1 << (BIT)); }
+
+  #else
+
+  #define SSD1306_PROBE_SETUP()
+  #define SSD1306_PROBE_BEGIN(BIT)
+  #define SSD1306_PROBE_END(BIT)
+
+  #endif
+
+#endif
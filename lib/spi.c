@@ -0,0 +1,252 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @desc        Serial Peripheral Interface - master for 4-wire SSD1306
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @datum       18.10.2026
+ * @file        spi.c
+ * @tested      AVR Atmega328
+ *
+ * @depend      spi.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Master Transmit Operation
+ */
+
+// include libraries
+#include "spi.h"
+
+#if defined(SPI_HARDWARE)
+
+// @var interrupt driven stream in progress
+volatile uint8_t _spiStreamBusy;
+
+#ifdef SPI_STREAM
+// @var interrupt driven stream - next byte, bytes left, chip select, clear sent bytes
+static uint8_t * volatile spiStreamData;
+static volatile uint16_t spiStreamLength;
+static volatile uint8_t spiStreamCs;
+static volatile uint8_t spiStreamClear;
+#endif
+
+/**
+ * @desc    SPI init - master, mode 0, MSB first, F_CPU / 2
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SPI_Init (void)
+{
+  // SS must be output in master mode, otherwise low level on it drops master mode
+  SPI_DDR |= (1 << SPI_SS) | (1 << SPI_MOSI) | (1 << SPI_SCK);
+  SPI_PORT |= (1 << SPI_SS);
+  // D/C & RES
+  SPI_DC_DDR |= (1 << SPI_DC);
+  SPI_RES_DDR |= (1 << SPI_RES);
+  SPI_RES_PORT |= (1 << SPI_RES);
+  // enable, master, fosc / 4 doubled by SPI2X => fosc / 2
+  SPCR = (1 << SPE) | (1 << MSTR);
+  SPSR = (1 << SPI2X);
+}
+
+/**
+ * @desc    SPI reset of display - RES low at least 3us, then wait for controller
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SPI_Reset (void)
+{
+  SPI_RES_PORT &= ~(1 << SPI_RES);
+  _delay_us (10);
+  SPI_RES_PORT |= (1 << SPI_RES);
+  _delay_us (10);
+}
+
+/**
+ * @desc    SPI Send byte
+ *
+ * @param   uint8_t
+ *
+ * @return  void
+ */
+void SPI_Send_Byte (uint8_t data)
+{
+  SPDR = data;
+  SPI_WAIT_TILL_SPIF_IS_SET();
+}
+
+/**
+ * @desc    SPI Send bytes - SPDR isn't buffered on transmit, next byte is fetched while
+ *          current one is shifted out (16 cycles at F_CPU / 2). Inlined with constant
+ *          'flash' & 'clear' into public variants.
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t flash - 1 data in PROGMEM, 0 data in RAM
+ * @param   uint8_t * clear - byte zeroed during transfer of every data byte, NULL none
+ * @param   uint16_t count - bytes to clear
+ *
+ * @return  void
+ */
+static inline __attribute__((always_inline)) void SPI_Send_Bytes (const uint8_t * data, uint16_t length, uint8_t flash, uint8_t * clear, uint16_t count)
+{
+  uint8_t next;
+
+  if (0 == length) {
+    return;
+  }
+  next = flash ? pgm_read_byte (data++) : *data++;
+  while (1) {
+    SPDR = next;
+    if (clear && count) {
+      count--;
+      *clear++ = 0;
+    }
+    if (0 == --length) {
+      break;
+    }
+    next = flash ? pgm_read_byte (data++) : *data++;
+    SPI_WAIT_TILL_SPIF_IS_SET();
+  }
+  SPI_WAIT_TILL_SPIF_IS_SET();
+}
+
+/**
+ * @desc    SPI Send buffer from RAM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  void
+ */
+void SPI_Send_Buffer (const uint8_t * data, uint16_t length)
+{
+  SPI_Send_Bytes (data, length, 0, NULL, 0);
+}
+
+/**
+ * @desc    SPI Send buffer from PROGMEM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  void
+ */
+void SPI_Send_Buffer_P (const uint8_t * data, uint16_t length)
+{
+  SPI_Send_Bytes (data, length, 1, NULL, 0);
+}
+
+/**
+ * @desc    SPI Send buffer from RAM & clear - 'count' bytes of 'clear' are zeroed
+ *          one per data byte while it is shifted out (may be the data itself)
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t * clear
+ * @param   uint16_t count -> 0 ... length
+ *
+ * @return  void
+ */
+void SPI_Send_BufferClear (const uint8_t * data, uint16_t length, uint8_t * clear, uint16_t count)
+{
+  SPI_Send_Bytes (data, length, 0, clear, count);
+}
+
+/**
+ * @desc    SPI Stream start - first byte written, rest by SPI_STC_vect
+ *
+ * @param   uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t chip select pin
+ * @param   uint8_t clear - 1 every byte is zeroed right after it is written to SPDR
+ *
+ * @return  void
+ */
+static void SPI_StreamStart (uint8_t * data, uint16_t length, uint8_t cs, uint8_t clear)
+{
+  if (0 == length) {
+    SPI_DESELECT (cs);
+    return;
+  }
+#ifdef SPI_STREAM
+  while (_spiStreamBusy);
+  spiStreamData = data + 1;
+  spiStreamLength = length - 1;
+  spiStreamCs = cs;
+  spiStreamClear = clear;
+  _spiStreamBusy = 1;
+  SPCR |= (1 << SPIE);
+  SPDR = *data;
+  if (clear) {
+    *data = 0;
+  }
+#else
+  SPI_Send_Bytes (data, length, 0, clear ? data : NULL, length);
+  SPI_DESELECT (cs);
+#endif
+}
+
+/**
+ * @desc    SPI Stream buffer from RAM - with SPI_STREAM defined bytes are sent from
+ *          SPI_STC_vect and chip select is released by the last interrupt, buffer must
+ *          stay untouched till SPI_StreamBusy () returns 0. Without SPI_STREAM the
+ *          transfer is blocking (no ISR is linked into application).
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t chip select pin
+ *
+ * @return  void
+ */
+void SPI_Stream (const uint8_t * data, uint16_t length, uint8_t cs)
+{
+  SPI_StreamStart ((uint8_t *) data, length, cs, 0);              // not written
+}
+
+/**
+ * @desc    SPI Stream buffer from RAM & clear - as SPI_Stream, buffer is blank when
+ *          SPI_StreamBusy () returns 0
+ *
+ * @param   uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t chip select pin
+ *
+ * @return  void
+ */
+void SPI_StreamClear (uint8_t * data, uint16_t length, uint8_t cs)
+{
+  SPI_StreamStart (data, length, cs, 1);
+}
+
+#ifdef SPI_STREAM
+/**
+ * @desc    SPI transfer complete - next byte of stream
+ *
+ * @param   SPI_STC_vect
+ *
+ * @return  void
+ */
+ISR (SPI_STC_vect)
+{
+  if (spiStreamLength) {
+    spiStreamLength--;
+    SPDR = *spiStreamData;
+    if (spiStreamClear) {
+      *spiStreamData = 0;
+    }
+    spiStreamData++;
+  } else {
+    SPCR &= ~(1 << SPIE);
+    SPI_DESELECT (spiStreamCs);
+    _spiStreamBusy = 0;
+  }
+}
+#endif
+
+#endif
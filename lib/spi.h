@@ -0,0 +1,190 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @desc        Serial Peripheral Interface - master for 4-wire SSD1306
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @datum       18.10.2026
+ * @file        spi.h
+ * @tested      AVR Atmega328
+ *
+ * @depend      avr/io.h, config.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Master, mode 0, MSB first, F_CPU / 2. Display pins:
+ *                D0 (SCK), D1 (MOSI), CS - any pin of SPI_CS_PORT, DC, RES
+ *              D/C selects command (0) or data (1) instead of TWI control bytes.
+ */
+
+#ifndef __SPI_H__
+#define __SPI_H__
+
+  // @includes
+  #include <stddef.h>
+  #include <avr/io.h>
+  #include <avr/pgmspace.h>
+  #include <avr/interrupt.h>
+  #include <util/delay.h>
+  #include "config.h"
+
+  // hardware SPI present & not stripped by SSD1306_USE_SPI (ATtiny USI parts have none,
+  // only TWI addresses work there)
+  // -------------------------------------------------------------------------------------
+  #if defined(SPDR) && SSD1306_USE_SPI
+    #define SPI_HARDWARE
+  #endif
+
+  // define pins for SPI communication
+  // -------------------------------------------------------------------------------------
+  #if defined(__AVR_ATmega16__)
+
+    #define SPI_DDR             DDRB
+    #define SPI_PORT            PORTB
+    #define SPI_SS              PB4
+    #define SPI_MOSI            PB5
+    #define SPI_SCK             PB7
+
+  #elif defined(__AVR_ATmega8__) || defined(__AVR_ATmega328P__)
+
+    #define SPI_DDR             DDRB
+    #define SPI_PORT            PORTB
+    #define SPI_SS              PB2
+    #define SPI_MOSI            PB3
+    #define SPI_SCK             PB5
+
+  #endif
+
+  // Chip select port - pin number is given by display address (SSD1306_SPI | pin)
+  // -------------------------------------------------------------------------------------
+  #ifndef SPI_CS_PORT
+    #define SPI_CS_DDR          SPI_DDR
+    #define SPI_CS_PORT         SPI_PORT
+  #endif
+
+  // Data / Command & Reset pins
+  // -------------------------------------------------------------------------------------
+  #ifndef SPI_DC
+    #define SPI_DC_DDR          DDRB
+    #define SPI_DC_PORT         PORTB
+    #define SPI_DC              PB1
+  #endif
+  #ifndef SPI_RES
+    #define SPI_RES_DDR         DDRB
+    #define SPI_RES_PORT        PORTB
+    #define SPI_RES             PB0
+  #endif
+
+  // Success
+  // -------------------------------------------------------------------------------------
+  #ifndef SUCCESS
+    #define SUCCESS             0
+  #endif
+
+  // D/C line
+  // -------------------------------------------------------------------------------------
+  #define SPI_DC_COMMAND()              { SPI_DC_PORT &= ~(1 << SPI_DC); }
+  #define SPI_DC_DATA()                 { SPI_DC_PORT |= (1 << SPI_DC); }
+
+  // Chip select line, active low
+  // -------------------------------------------------------------------------------------
+  #define SPI_SELECT(CS)                { SPI_CS_PORT &= ~(1 << (CS)); }
+  #define SPI_DESELECT(CS)              { SPI_CS_PORT |= (1 << (CS)); }
+
+  // SPI wait till transfer complete
+  #define SPI_WAIT_TILL_SPIF_IS_SET()   { while (!(SPSR & (1 << SPIF))); }
+
+  // @var interrupt driven stream in progress
+  extern volatile uint8_t _spiStreamBusy;
+
+  /**
+   * @desc    SPI init - master, mode 0, F_CPU / 2
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SPI_Init (void);
+
+  /**
+   * @desc    SPI reset of display - RES low pulse
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SPI_Reset (void);
+
+  /**
+   * @desc    SPI Send byte
+   *
+   * @param   uint8_t
+   *
+   * @return  void
+   */
+  void SPI_Send_Byte (uint8_t);
+
+  /**
+   * @desc    SPI Send buffer from RAM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  void
+   */
+  void SPI_Send_Buffer (const uint8_t *, uint16_t);
+
+  /**
+   * @desc    SPI Send buffer from PROGMEM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  void
+   */
+  void SPI_Send_Buffer_P (const uint8_t *, uint16_t);
+
+  /**
+   * @desc    SPI Send buffer from RAM & clear bytes during transfer
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   * @param   uint8_t *
+   * @param   uint16_t
+   *
+   * @return  void
+   */
+  void SPI_Send_BufferClear (const uint8_t *, uint16_t, uint8_t *, uint16_t);
+
+  /**
+   * @desc    SPI Stream buffer from RAM by interrupt (blocking without SPI_STREAM)
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   * @param   uint8_t chip select pin released at the end
+   *
+   * @return  void
+   */
+  void SPI_Stream (const uint8_t *, uint16_t, uint8_t);
+
+  /**
+   * @desc    SPI Stream buffer from RAM & clear sent bytes
+   *
+   * @param   uint8_t *
+   * @param   uint16_t
+   * @param   uint8_t chip select pin released at the end
+   *
+   * @return  void
+   */
+  void SPI_StreamClear (uint8_t *, uint16_t, uint8_t);
+
+  /**
+   * @desc    SPI Stream in progress
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  static inline uint8_t SPI_StreamBusy (void) { return _spiStreamBusy; }
+
+#endif
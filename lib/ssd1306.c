@@ -24,6 +24,7 @@
 // @includes
 #include "ssd1306.h"
 
+#if (SSD1306_INIT_TABLE == SSD1306_INIT_ADAFRUIT)
 // @const List of init commands with arguments by Adafruit
 // @link https://github.com/adafruit/Adafruit_SSD1306
 const uint8_t INIT_SSD1306_ADAFRUIT[] PROGMEM = {
@@ -41,7 +42,7 @@ const uint8_t INIT_SSD1306_ADAFRUIT[] PROGMEM = {
                                                                   // 0x02 /  Page Addressing Mode (RESET)
   SSD1306_SEG_REMAP_OP, 0,                                        // 0xA0 / remap 0xA1
   SSD1306_COM_SCAN_DIR_OP, 0,                                     // 0xC8
-  SSD1306_COM_PIN_CONF, 0, 0x02,                                  // 0xDA / 0x12 - Disable COM Left/Right remap, Alternative COM pin configuration
+  SSD1306_COM_PIN_CONF, 1, 0x02,                                  // 0xDA / 0x12 - Disable COM Left/Right remap, Alternative COM pin configuration
                                                                   //        0x12 - for 128 x 64 version
                                                                   //        0x02 - for 128 x 32 version
   SSD1306_SET_CONTRAST, 1, 0x8F,                                  // 0x81 / 0x8F - reset value (max 0xFF)
@@ -54,6 +55,8 @@ const uint8_t INIT_SSD1306_ADAFRUIT[] PROGMEM = {
   SSD1306_DISPLAY_ON, 0                                           // 0xAF / Set Display ON  
 };
 
+#define SSD1306_INIT_LIST               INIT_SSD1306_ADAFRUIT
+#else
 // @const uint8_t - List of init commands according to datasheet SSD1306
 const uint8_t INIT_SSD1306[] PROGMEM = {
   17,                                                             // number of initializers
@@ -83,9 +86,89 @@ const uint8_t INIT_SSD1306[] PROGMEM = {
   SSD1306_DISPLAY_ON, 0                                           // 0xAF = Set Display ON
 };
 
+#define SSD1306_INIT_LIST               INIT_SSD1306
+#endif
+
+// @const uint16_t - SCL frequency steps of probe in kHz, 800kHz - 1MHz is overclock
+const uint16_t SSD1306_PROBE_STEPS[] PROGMEM = { 100, 200, 400, 600, 800, 1000 };
+
+#if defined(SSD1306_SPARSE)
+// @var page pool - pages of cache memory in use, blank pages are not stored
+static uint8_t cachePool[SSD1306_SPARSE_PAGES][END_COLUMN_ADDR + 1];
+// @var pool slot + 1 of every page, 0 = blank page
+static uint8_t cacheSlot[END_PAGE_ADDR + 1];
+// @var pages known blank in display RAM, bit per page
+static uint8_t cacheBlank;
+
+// blank page, already blank on display, is not flushed
+#define SSD1306_CACHE_SKIP(PAGE)        (!cacheSlot[PAGE] && (cacheBlank & (1 << (PAGE))))
+#define SSD1306_CACHE_SENT(PAGE)        SSD1306_CacheSent (PAGE)
+#define SSD1306_INK(DATA, LENGTH, MASK) SSD1306_Ink (DATA, LENGTH, MASK)
+#else
 // @var array Chache memory Lcd 8 * 128 = 1024
 static char cacheMemLcd[CACHE_SIZE_MEM];
 
+#define SSD1306_CACHE_SKIP(PAGE)        0
+#define SSD1306_CACHE_SENT(PAGE)
+#define SSD1306_INK(DATA, LENGTH, MASK) 1
+#endif
+
+// @var set area
+unsigned int _counter;
+
+// @var deferred commands & arguments, emitted at the start of the next flush
+static uint8_t cmdQueue[SSD1306_QUEUE_SIZE];
+static uint8_t cmdAddress[SSD1306_QUEUE_SIZE];                      // target of every byte
+static uint8_t cmdQueued;
+static uint8_t cmdTarget;                                           // address of transaction
+static uint8_t cmdHold;                                             // queue waits, no room
+static uint8_t cmdMode = SSD1306_IMMEDIATE;
+
+#if SSD1306_USE_ASYNC
+// @var incremental flush - next byte of cache memory to send, 0 = frame start
+static uint16_t stepPos;
+#endif
+
+// @var flush mode, first byte of frame acknowledged but not yet cleared
+static uint8_t flushMode = SSD1306_FLUSH_KEEP;
+static uint16_t flushCleared;
+
+// @var rotation, SSD1306_ROTATE_0 ... SSD1306_ROTATE_270
+static uint8_t rotation;
+
+#if defined(SSD1306_LAYERS)
+// @var drawing target - buffer of 'cacheTargetPages' pages, NULL = cache memory
+static uint8_t * cacheTarget;
+static uint8_t cacheTargetPages;
+#endif
+
+// Viewport - origin & clip rectangle, logical coordinates of screen, inclusive
+// ---------------------------------------------------------------------------------------
+typedef struct {
+  uint8_t ox, oy;                                                 // origin
+  uint8_t x1, y1, x2, y2;                                         // clip rectangle
+} SSD1306_View;
+
+// @var viewports, views[0] = full screen
+static SSD1306_View views[SSD1306_VIEWPORTS] = { { 0, 0, 0, 0, MAX_X, MAX_Y - 1 } };
+static uint8_t viewTop;
+
+// @var clip rectangle of top viewport in panel columns & rows (rotation applied)
+static uint8_t clipCol1, clipCol2 = END_COLUMN_ADDR;
+static uint8_t clipRow1, clipRow2 = MAX_Y - 1;
+
+// Outcodes of line end against clip rectangle (Cohen-Sutherland)
+// ---------------------------------------------------------------------------------------
+#define SSD1306_OUT_LEFT                0x01
+#define SSD1306_OUT_RIGHT               0x02
+#define SSD1306_OUT_TOP                 0x04
+#define SSD1306_OUT_BOTTOM              0x08
+
+#if defined(SPI_HARDWARE)
+// @var transport of current transaction, 0 = TWI, SSD1306_SPI | CS pin = SPI
+static uint8_t ssd1306Spi;
+#endif
+
 /**
  * +------------------------------------------------------------------------------------+
  * |== PRIVATE FUNCTIONS ===============================================================|
@@ -93,185 +176,1582 @@ static char cacheMemLcd[CACHE_SIZE_MEM];
  */
 
 /**
- * @brief   SSD1306 Init
+ * @brief   SSD1306 Abort transaction - release the bus after failed transfer,
+ *          stuck bus (timeout) is recovered by bit-bang, NACK / arbitration only stopped
+ *
+ * @param   uint8_t status
+ *
+ * @return  uint8_t status
+ */
+static uint8_t SSD1306_Abort (uint8_t status)
+{
+  SSD1306_TRACE_EVENT_ERROR (status);
+  if (TWI_ERR_TIMEOUT == status) {
+    SSD1306_STATS_INC (timeouts);
+    TWI_BusRecovery ();
+  } else {
+    SSD1306_STATS_INC (nacks);
+    TWI_Stop ();
+  }
+
+  return status;
+}
+
+/**
+ * @brief   SSD1306 Send byte, bus is released on failure
+ *
+ * @param   uint8_t byte
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_Send_Byte (uint8_t data)
+{
+  uint8_t status = INIT_STATUS;
+
+  SSD1306_TRACE_EVENT_BYTE (data);
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SPI_Send_Byte (data);
+    return SSD1306_SUCCESS;
+  }
+#endif
+  status = TWI_MT_Send_Data (data);
+  if (SSD1306_SUCCESS != status) {
+    return SSD1306_Abort (status);
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+#if defined(SSD1306_SPARSE)
+/**
+ * @brief   SSD1306 Cache allocate page from pool, cleared
+ *
+ * @param   uint8_t page
+ *
+ * @return  uint8_t * NULL if pool is exhausted
+ */
+static uint8_t * SSD1306_CacheAlloc (uint8_t page)
+{
+  uint8_t used = 0;
+  uint8_t slot = 0;
+  uint8_t i;
+
+  for (i = 0; i <= END_PAGE_ADDR; i++) {
+    if (cacheSlot[i]) {
+      used |= 1 << (cacheSlot[i] - 1);
+    }
+  }
+  while ((slot < SSD1306_SPARSE_PAGES) && (used & (1 << slot))) {
+    slot++;
+  }
+  if (SSD1306_SPARSE_PAGES == slot) {
+    return NULL;                                                  // pool exhausted
+  }
+  memset (cachePool[slot], CLEAR_COLOR, END_COLUMN_ADDR + 1);
+  cacheSlot[page] = slot + 1;
+
+  return cachePool[slot];
+}
+
+/**
+ * @brief   SSD1306 Cache page sent - page found blank goes back to pool, display RAM
+ *          of blank page is marked blank
+ *
+ * @param   uint8_t page
+ *
+ * @return  void
+ */
+static void SSD1306_CacheSent (uint8_t page)
+{
+  const uint8_t * cache;
+  uint8_t i = 0;
+
+  if (cacheSlot[page]) {
+    cache = cachePool[cacheSlot[page] - 1];
+    while ((i <= END_COLUMN_ADDR) && (CLEAR_COLOR == cache[i])) {
+      i++;
+    }
+    if (i <= END_COLUMN_ADDR) {
+      cacheBlank &= ~(1 << page);                                 // lit pixels
+      return;
+    }
+    cacheSlot[page] = 0;                                          // released
+  }
+  cacheBlank |= 1 << page;
+}
+
+#if SSD1306_USE_TEXT
+/**
+ * @brief   SSD1306 Columns have lit pixels inside row mask
+ *
+ * @param   const uint8_t * columns
+ * @param   uint8_t number of columns
+ * @param   uint8_t row mask
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_Ink (const uint8_t * data, uint8_t length, uint8_t mask)
+{
+  uint8_t ink = 0;
+
+  while (length--) {
+    ink |= *data++;
+  }
+
+  return ink & mask;
+}
+#endif
+#endif
+
+/**
+ * @brief   SSD1306 Cache byte - the only access to cache memory, sparse cache
+ *          allocates page on demand
+ *
+ * @param   uint16_t counter -> 0 ... CACHE_SIZE_MEM - 1
+ * @param   uint8_t ink - 1 page is allocated if blank, 0 blank page gives NULL
+ *
+ * @return  uint8_t * NULL for blank page without ink or exhausted pool
+ */
+static inline uint8_t * SSD1306_CacheByte (uint16_t counter, uint8_t ink)
+{
+#if defined(SSD1306_LAYERS)
+  if (cacheTarget) {                                              // layer buffer
+    return ((counter >> 7) < cacheTargetPages) ? &cacheTarget[counter] : NULL;
+  }
+#endif
+#if defined(SSD1306_SPARSE)
+  uint8_t page = counter >> 7;                                    // counter / 128
+  uint8_t * cache;
+
+  if (cacheSlot[page]) {
+    return &cachePool[cacheSlot[page] - 1][counter & END_COLUMN_ADDR];
+  }
+  if (0 == ink) {
+    return NULL;
+  }
+  cache = SSD1306_CacheAlloc (page);
+  if (NULL == cache) {
+    return NULL;
+  }
+
+  return &cache[counter & END_COLUMN_ADDR];
+#else
+  (void) ink;
+
+  return (uint8_t *) &cacheMemLcd[counter];
+#endif
+}
+
+/**
+ * @brief   SSD1306 Send cache memory range, sparse cache sends blank pages as zeros
+ *
+ * @param   uint16_t position -> 0 ... CACHE_SIZE_MEM - 1
+ * @param   uint16_t length
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_Send_Cache (uint16_t position, uint16_t length)
+{
+#if defined(SSD1306_SPARSE)
+  uint8_t status = SSD1306_SUCCESS;
+  const uint8_t * cache;
+  uint16_t chunk;
+  uint16_t i;
+
+  while (length && (SSD1306_SUCCESS == status)) {
+    chunk = (END_COLUMN_ADDR + 1) - (position & END_COLUMN_ADDR); // to the end of page
+    if (chunk > length) {
+      chunk = length;
+    }
+    cache = SSD1306_CacheByte (position, 0);
+    if (cache) {
+      status = SSD1306_Send_Buffer (cache, chunk);
+    } else {
+      for (i = 0; (i < chunk) && (SSD1306_SUCCESS == status); i++) {
+        status = SSD1306_Send_Data (CLEAR_COLOR);                 // zero run
+      }
+    }
+    position += chunk;
+    length -= chunk;
+  }
+
+  return status;
+#else
+  return SSD1306_Send_Buffer ((const uint8_t *) &cacheMemLcd[position], length);
+#endif
+}
+
+/**
+ * @brief   SSD1306 Send frame range - flush mode clear zeroes bytes acknowledged
+ *          before 'position' during transfer of this range (one range behind, so
+ *          range that fails is resent intact); blank pages of sparse cache are
+ *          released by SSD1306_FrameEnd
+ *
+ * @param   uint16_t position -> 0 ... CACHE_SIZE_MEM - 1, ascending in frame
+ * @param   uint16_t length
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_Send_Frame (uint16_t position, uint16_t length)
+{
+#if !defined(SSD1306_SPARSE)
+  uint8_t status = INIT_STATUS;
+  uint16_t count;
+
+  if ((SSD1306_FLUSH_CLEAR == flushMode) && (position > flushCleared)) {
+    count = position - flushCleared;
+    if (count > length) {
+      count = length;
+    }
+    SSD1306_STATS_ADD (bytes_data, length);
+    SSD1306_TRACE_EVENT_BUFFER ((const uint8_t *) &cacheMemLcd[position], length, 0);
+#if defined(SPI_HARDWARE)
+    if (ssd1306Spi) {
+      SPI_Send_BufferClear ((const uint8_t *) &cacheMemLcd[position], length, (uint8_t *) &cacheMemLcd[flushCleared], count);
+      flushCleared += count;
+      return SSD1306_SUCCESS;
+    }
+#endif
+    status = TWI_MT_Send_BufferClear ((const uint8_t *) &cacheMemLcd[position], length, (uint8_t *) &cacheMemLcd[flushCleared], count);
+    if (SSD1306_SUCCESS != status) {
+      return SSD1306_Abort (status);                              // cleared bytes were acked
+    }
+    flushCleared += count;
+    return SSD1306_SUCCESS;
+  }
+#endif
+
+  return SSD1306_Send_Cache (position, length);
+}
+
+/**
+ * @brief   SSD1306 Frame end - flush mode clear zeroes the rest of cache memory, also
+ *          after failed frame (frame is dropped, next one is drawn from blank)
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+static void SSD1306_FrameEnd (void)
+{
+  if (SSD1306_FLUSH_CLEAR == flushMode) {
+#if defined(SSD1306_SPARSE)
+    memset (cacheSlot, 0, sizeof (cacheSlot));                    // all pages back to pool
+#else
+    memset (&cacheMemLcd[flushCleared], CLEAR_COLOR, CACHE_SIZE_MEM - flushCleared);
+#endif
+  }
+  flushCleared = 0;
+}
+
+/**
+ * @brief   SSD1306 Clip update - clip rectangle of top viewport in panel coordinates,
+ *          portrait: logical (x, y) -> panel (y, MAX_Y - 1 - x)
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+static void SSD1306_ClipUpdate (void)
+{
+  const SSD1306_View * view = &views[viewTop];
+
+  if (rotation & SSD1306_PORTRAIT) {
+    clipCol1 = view->y1;
+    clipCol2 = view->y2;
+    clipRow1 = (MAX_Y - 1) - view->x2;
+    clipRow2 = (MAX_Y - 1) - view->x1;
+    return;
+  }
+  clipCol1 = view->x1;
+  clipCol2 = view->x2;
+  clipRow1 = view->y1;
+  clipRow2 = view->y2;
+}
+
+#if SSD1306_USE_GRAPHICS
+/**
+ * @brief   SSD1306 Plot pixel - no range check, point is inside clip rectangle
+ *
+ * @param   uint8_t x - logical, absolute
+ * @param   uint8_t y - logical, absolute
+ *
+ * @return  uint8_t
+ */
+static inline uint8_t SSD1306_PlotPixel (uint8_t x, uint8_t y)
+{
+  uint8_t page = 0;
+  uint8_t pixel = 0;
+  uint8_t * cache;
+
+  if (rotation & SSD1306_PORTRAIT) {                              // logical -> panel
+    page = x;
+    x = y;
+    y = (MAX_Y - 1) - page;
+  }
+  page = y >> 3;                                                  // find page (y / 8)
+  pixel = 1 << (y - (page << 3));                                 // which pixel (y % 8)
+  _counter = x + (page << 7);                                     // update counter
+  cache = SSD1306_CacheByte (_counter++, 1);
+  if (NULL == cache) {
+    return SSD1306_ERROR;                                         // pool exhausted
+  }
+  *cache |= pixel;                                                // save pixel
+  SSD1306_STATS_DRAW (1);
+
+  return SSD1306_SUCCESS;
+}
+#endif
+
+#if SSD1306_USE_TEXT
+/**
+ * @brief   SSD1306 Put columns into one page - clipped once by clip rectangle,
+ *          columns outside are dropped, rows outside are kept by mask
+ *
+ * @param   uint16_t counter of first column
+ * @param   const uint8_t * columns in page format
+ * @param   uint8_t number of columns -> 1 ... 8
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_PutColumns (uint16_t counter, const uint8_t * data, uint8_t length)
+{
+  uint8_t column = counter & END_COLUMN_ADDR;                     // counter % 128
+  uint8_t page = counter >> 7;                                    // counter / 128
+  uint8_t first = 0;
+  uint8_t mask = 0xFF;
+  uint8_t ink;
+  uint8_t * cache;
+
+  // clip
+  // -------------------------------------------------------------------------------------
+  if ((page < (clipRow1 >> 3)) || (page > (clipRow2 >> 3)) ||
+      (column > clipCol2) || ((column + length - 1) < clipCol1)) {
+    return SSD1306_SUCCESS;                                       // outside
+  }
+  if (column < clipCol1) {
+    first = clipCol1 - column;
+  }
+  if ((column + length - 1) > clipCol2) {
+    length = clipCol2 - column + 1;
+  }
+  if (page == (clipRow1 >> 3)) {
+    mask = 0xFF << (clipRow1 & 0x07);
+  }
+  if (page == (clipRow2 >> 3)) {
+    mask &= 0xFF >> (7 - (clipRow2 & 0x07));
+  }
+  data += first;
+  length -= first;
+  // write, blank columns on blank page of sparse cache allocate nothing
+  // -------------------------------------------------------------------------------------
+  ink = SSD1306_INK (data, length, mask);
+  cache = SSD1306_CacheByte (counter + first, ink);
+  if (NULL == cache) {
+    return ink ? SSD1306_ERROR : SSD1306_SUCCESS;                 // pool exhausted
+  }
+  if (0xFF == mask) {
+    while (length--) {
+      *cache++ = *data++;
+    }
+  } else {
+    while (length--) {
+      *cache = (*cache & ~mask) | (*data++ & mask);
+      cache++;
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+#endif
+
+#if SSD1306_USE_GRAPHICS
+/**
+ * @brief   SSD1306 Outcode of point against clip rectangle of top viewport
+ *
+ * @param   int16_t x
+ * @param   int16_t y
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_OutCode (int16_t x, int16_t y)
+{
+  const SSD1306_View * view = &views[viewTop];
+  uint8_t code = 0;
+
+  if (x < view->x1) {
+    code |= SSD1306_OUT_LEFT;
+  } else if (x > view->x2) {
+    code |= SSD1306_OUT_RIGHT;
+  }
+  if (y < view->y1) {
+    code |= SSD1306_OUT_TOP;
+  } else if (y > view->y2) {
+    code |= SSD1306_OUT_BOTTOM;
+  }
+
+  return code;
+}
+
+/**
+ * @brief   SSD1306 Clip line (Cohen-Sutherland) - ends are moved onto clip rectangle,
+ *          all pixels between them are then inside
+ *
+ * @param   int16_t * line -> x1, y1, x2, y2
+ *
+ * @return  uint8_t SSD1306_ERROR if line is outside
+ */
+static uint8_t SSD1306_ClipLine (int16_t * line)
+{
+  const SSD1306_View * view = &views[viewTop];
+  uint8_t code1 = SSD1306_OutCode (line[0], line[1]);
+  uint8_t code2 = SSD1306_OutCode (line[2], line[3]);
+  int16_t dx, dy;
+  int16_t x, y;
+  uint8_t code;
+
+  while (code1 | code2) {
+    if (code1 & code2) {
+      return SSD1306_ERROR;                                       // outside
+    }
+    code = code1 ? code1 : code2;
+    dx = line[2] - line[0];
+    dy = line[3] - line[1];
+    if (code & SSD1306_OUT_TOP) {
+      y = view->y1;
+      x = line[0] + (int32_t) dx * (y - line[1]) / dy;
+    } else if (code & SSD1306_OUT_BOTTOM) {
+      y = view->y2;
+      x = line[0] + (int32_t) dx * (y - line[1]) / dy;
+    } else if (code & SSD1306_OUT_LEFT) {
+      x = view->x1;
+      y = line[1] + (int32_t) dy * (x - line[0]) / dx;
+    } else {
+      x = view->x2;
+      y = line[1] + (int32_t) dy * (x - line[0]) / dx;
+    }
+    if (code == code1) {
+      line[0] = x;
+      line[1] = y;
+      code1 = SSD1306_OutCode (x, y);
+    } else {
+      line[2] = x;
+      line[3] = y;
+      code2 = SSD1306_OutCode (x, y);
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+#endif
+
+/**
+ * @brief   SSD1306 Init
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Init (uint8_t address)
+{ 
+  const uint8_t * list = SSD1306_INIT_LIST;
+  uint8_t status = INIT_STATUS;                                   // init status
+  uint8_t arguments;
+  uint8_t commands = pgm_read_byte (list++);
+
+  SSD1306_PROBE_SETUP ();
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_INIT);
+#if defined(SSD1306_SPARSE)
+  cacheBlank = 0;                                                 // display RAM unknown
+#endif
+  // TWI / SPI: Init
+  // -------------------------------------------------------------------------------------
+#if defined(SPI_HARDWARE)
+  if (address & SSD1306_SPI) {
+    SPI_Init ();
+    SPI_CS_DDR |= (1 << (address & SSD1306_SPI_CS));
+    SPI_DESELECT (address & SSD1306_SPI_CS);
+    SPI_Reset ();
+  } else {
+    TWI_Init ();
+  }
+#else
+  TWI_Init ();
+#endif
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    SSD1306_PROBE_END (SSD1306_PROBE_INIT);
+    return status;
+  }
+  // Commands & Arguments
+  // -------------------------------------------------------------------------------------
+  while (commands--) {
+    // Command
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_Command (pgm_read_byte(list++));
+    if (SSD1306_SUCCESS != status) {
+      SSD1306_PROBE_END (SSD1306_PROBE_INIT);
+      return status;
+    }
+    // Arguments
+    // -----------------------------------------------------------------------------------
+    arguments = pgm_read_byte (list++);
+    while (arguments--) {
+      status = SSD1306_Send_Command (pgm_read_byte(list++));  // argument
+      if (SSD1306_SUCCESS != status) {
+        SSD1306_PROBE_END (SSD1306_PROBE_INIT);
+        return status;
+      }
+    }
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+  SSD1306_PROBE_END (SSD1306_PROBE_INIT);
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send Start and SLAW request, bus is released on failure
+ *          SPI: select chip (address = SSD1306_SPI | CS pin)
+ *
+ * @param   uint8_t
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_StartAndSLAW (uint8_t address)
+{
+  uint8_t status = INIT_STATUS;
+
+  cmdTarget = address;
+  SSD1306_STATS_INC (transactions);
+  SSD1306_TRACE_EVENT_START (address);
+  // SPI: chip select
+  // -------------------------------------------------------------------------------------
+#if defined(SPI_HARDWARE)
+  if (address & SSD1306_SPI) {
+    while (SPI_StreamBusy ());                                    // stream of previous flush
+    ssd1306Spi = address;
+    SSD1306_PROBE_BEGIN (SSD1306_PROBE_BUS);
+    SPI_SELECT (address & SSD1306_SPI_CS);
+    return SSD1306_SUCCESS;
+  }
+  ssd1306Spi = 0;
+#else
+  if (address & SSD1306_SPI) {
+    return SSD1306_ERROR;                                         // no SPI on this part
+  }
+#endif
+  // TWI: start
+  // -------------------------------------------------------------------------------------
+  status = TWI_MT_Start ();
+  if (SSD1306_SUCCESS != status) {
+    return SSD1306_Abort (status);
+  }
+  // TWI: send SLAW
+  // -------------------------------------------------------------------------------------
+  status = TWI_MT_Send_SLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return SSD1306_Abort (status);
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send command, bus is released on failure
+ *          SPI: D/C low, no control byte
+ *
+ * @param   uint8_t command
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Command (uint8_t command)
+{
+  uint8_t status = INIT_STATUS;
+
+  // SPI: command
+  // -------------------------------------------------------------------------------------
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SSD1306_STATS_INC (bytes_cmd);
+    SSD1306_TRACE_EVENT_DC (0);
+    SSD1306_TRACE_EVENT_BYTE (command);
+    SPI_DC_COMMAND ();
+    SPI_Send_Byte (command);
+    return SSD1306_SUCCESS;
+  }
+#endif
+  SSD1306_STATS_ADD (bytes_cmd, 2);
+  // send control byte
+  // -------------------------------------------------------------------------------------   
+  status = SSD1306_Send_Byte (SSD1306_COMMAND);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // send command
+  // -------------------------------------------------------------------------------------   
+  status = SSD1306_Send_Byte (command);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send data byte, bus is released on failure
+ *
+ * @param   uint8_t data
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Data (uint8_t data)
+{
+  SSD1306_STATS_INC (bytes_data);
+
+  return SSD1306_Send_Byte (data);
+}
+
+/**
+ * @brief   SSD1306 Send buffer from RAM, bus is released on failure
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Buffer (const uint8_t * data, uint16_t length)
+{
+  uint8_t status = INIT_STATUS;
+
+  SSD1306_STATS_ADD (bytes_data, length);
+  SSD1306_TRACE_EVENT_BUFFER (data, length, 0);
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SPI_Send_Buffer (data, length);
+    return SSD1306_SUCCESS;
+  }
+#endif
+  status = TWI_MT_Send_Buffer (data, length);
+  if (SSD1306_SUCCESS != status) {
+    return SSD1306_Abort (status);
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send buffer from PROGMEM, bus is released on failure
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Buffer_P (const uint8_t * data, uint16_t length)
+{
+  uint8_t status = INIT_STATUS;
+
+  SSD1306_STATS_ADD (bytes_data, length);
+  SSD1306_TRACE_EVENT_BUFFER (data, length, 1);
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SPI_Send_Buffer_P (data, length);
+    return SSD1306_SUCCESS;
+  }
+#endif
+  status = TWI_MT_Send_Buffer_P (data, length);
+  if (SSD1306_SUCCESS != status) {
+    return SSD1306_Abort (status);
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send data stream start - TWI: control byte, SPI: D/C high
+ *
+ * @param   void
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_DataStream (void)
+{
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SSD1306_TRACE_EVENT_DC (1);
+    SPI_DC_DATA ();
+    return SSD1306_SUCCESS;
+  }
+#endif
+
+  SSD1306_STATS_INC (bytes_cmd);
+
+  return SSD1306_Send_Byte (SSD1306_DATA_STREAM);
+}
+
+/**
+ * @brief   SSD1306 Send stop - TWI: stop condition, SPI: release chip select
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_Send_Stop (void)
+{
+  SSD1306_TRACE_EVENT_STOP ();
+#if defined(SPI_HARDWARE)
+  if (ssd1306Spi) {
+    SPI_DESELECT (ssd1306Spi & SSD1306_SPI_CS);
+    SSD1306_PROBE_END (SSD1306_PROBE_BUS);
+    return;
+  }
+#endif
+  TWI_Stop ();
+}
+
+/**
+ * @brief   SSD1306 Queued - bytes of deferred commands for display
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_Queued (uint8_t address)
+{
+  uint8_t count = 0;
+  uint8_t i = 0;
+
+  while (i < cmdQueued) {
+    if (address == cmdAddress[i++]) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief   SSD1306 Send deferred commands of display addressed by current transaction,
+ *          they are removed from queue only if all were acknowledged, commands of other
+ *          displays stay queued in order
+ *
+ * @param   void
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Queue (void)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t kept = 0;
+  uint8_t i = 0;
+
+  if (cmdHold) {
+    return SSD1306_SUCCESS;                                       // step without room
+  }
+  while (i < cmdQueued) {
+    if (cmdTarget == cmdAddress[i]) {
+      status = SSD1306_Send_Command (cmdQueue[i]);
+      if (SSD1306_SUCCESS != status) {
+        return status;
+      }
+    }
+    i++;
+  }
+  // compact - keep commands of other displays
+  // -------------------------------------------------------------------------------------
+  for (i = 0; i < cmdQueued; i++) {
+    if (cmdTarget != cmdAddress[i]) {
+      cmdQueue[kept] = cmdQueue[i];
+      cmdAddress[kept++] = cmdAddress[i];
+    }
+  }
+  cmdQueued = kept;
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Send window - restrict GDDRAM write area, in horizontal addressing
+ *          mode the address pointer wraps inside this window, deferred commands are
+ *          sent before
+ *
+ * @param   uint8_t start column
+ * @param   uint8_t end column
+ * @param   uint8_t start page
+ * @param   uint8_t end page
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Send_Window (uint8_t x1, uint8_t x2, uint8_t p1, uint8_t p2)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t window[6] = { SSD1306_SET_COLUMN_ADDR, x1, x2, SSD1306_SET_PAGE_ADDR, p1, p2 };
+  uint8_t i = 0;
+
+  // deferred commands first, window starts every flush
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Queue ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+#if defined(SSD1306_SPARSE)
+  cacheBlank &= ~((0xFF << p1) & (0xFF >> (7 - p2)));             // pages to be rewritten
+#endif
+  // commands & arguments
+  // -------------------------------------------------------------------------------------
+  while (i < sizeof (window)) {
+    status = SSD1306_Send_Command (window[i++]);
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * +------------------------------------------------------------------------------------+
+ * |== PUBLIC FUNCTIONS ================================================================|
+ * +------------------------------------------------------------------------------------+
+ */
+
+/**
+ * @brief   SSD1306 Command mode
+ *
+ * @param   uint8_t mode -> SSD1306_IMMEDIATE / SSD1306_DEFERRED
+ *
+ * @return  void
+ */
+void SSD1306_SetCommandMode (uint8_t mode)
+{
+  cmdMode = mode;
+}
+
+/**
+ * @brief   SSD1306 Flush mode - SSD1306_FLUSH_CLEAR: SSD1306_UpdateScreen,
+ *          SSD1306_UpdateStep (SSD1306_UpdateShared) and SSD1306_StreamScreen zero
+ *          cache memory during transfer, SSD1306_ClearScreen before drawing of next
+ *          frame is not needed
+ *
+ * @param   uint8_t mode -> SSD1306_FLUSH_KEEP / SSD1306_FLUSH_CLEAR
+ *
+ * @return  void
+ */
+void SSD1306_SetFlushMode (uint8_t mode)
+{
+  flushMode = mode;
+  flushCleared = 0;
+}
+
+/**
+ * @brief   SSD1306 Commands - immediate mode: own transaction right now, deferred mode:
+ *          queued and sent at the start of the next flush in the same transaction as
+ *          the data. Full queue is sent first, oldest display first, every command
+ *          in own transaction to its own address.
+ *
+ * @param   uint8_t address
+ * @param   const uint8_t * commands & arguments
+ * @param   uint8_t number of bytes
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_Commands (uint8_t address, const uint8_t * commands, uint8_t count)
+{
+  uint8_t status = INIT_STATUS;
+
+  if (count > SSD1306_QUEUE_SIZE) {
+    return SSD1306_ERROR;
+  }
+  // deferred
+  // -------------------------------------------------------------------------------------
+  if (SSD1306_DEFERRED == cmdMode) {
+    while ((cmdQueued + count) > SSD1306_QUEUE_SIZE) {
+      status = SSD1306_FlushCommands (cmdAddress[0]);
+      if (SSD1306_SUCCESS != status) {
+        return status;
+      }
+    }
+    memcpy (&cmdQueue[cmdQueued], commands, count);
+    memset (&cmdAddress[cmdQueued], address, count);
+    cmdQueued += count;
+    return SSD1306_SUCCESS;
+  }
+  // immediate - TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // send commands
+  // -------------------------------------------------------------------------------------
+  while (count--) {
+    status = SSD1306_Send_Command (*commands++);
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Flush commands - send deferred commands of display without waiting
+ *          for flush
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_FlushCommands (uint8_t address)
+{
+  uint8_t status = INIT_STATUS;
+
+  if (0 == SSD1306_Queued (address)) {
+    return SSD1306_SUCCESS;
+  }
+  // TWI: start & SLAW
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // send commands
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Queue ();
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
+  // TWI: Stop
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_Stop ();
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Normal colors
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_NormalScreen (uint8_t address)
+{
+  const uint8_t command = SSD1306_DIS_NORMAL;
+
+  return SSD1306_Commands (address, &command, 1);
+}
+
+/**
+ * @brief   SSD1306 Inverse colors
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_InverseScreen (uint8_t address)
+{
+  const uint8_t command = SSD1306_DIS_INVERSE;
+
+  return SSD1306_Commands (address, &command, 1);
+}
+
+/**
+ * @brief   SSD1306 Contrast
+ *
+ * @param   uint8_t address
+ * @param   uint8_t contrast -> 0x00 ... 0xFF
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_SetContrast (uint8_t address, uint8_t contrast)
+{
+  const uint8_t commands[2] = { SSD1306_SET_CONTRAST, contrast };
+
+  return SSD1306_Commands (address, commands, 2);
+}
+
+/**
+ * @brief   SSD1306 Rotation - 180 flips segment & COM remap, so it costs nothing;
+ *          90 / 270 (portrait) draw with transformed coordinates, 270 = 90 + flip.
+ *          Cache memory keeps panel orientation, content is not redrawn, viewports
+ *          are reset to full screen.
+ *
+ *          Portrait: width MAX_Y, height MAX_X + 1, logical (x, y) -> panel
+ *          (y, MAX_Y - 1 - x). Text cells are 8 x 8, SSD1306_SetPosition (x, row)
+ *          with x multiple of 8.
+ *
+ * @param   uint8_t address
+ * @param   uint8_t rotation -> SSD1306_ROTATE_0 ... SSD1306_ROTATE_270
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_SetRotation (uint8_t address, uint8_t rotate)
+{
+  uint8_t commands[2] = { SSD1306_SEG_REMAP_OP, SSD1306_COM_SCAN_DIR_OP };
+
+  if (rotate > SSD1306_ROTATE_270) {
+    return SSD1306_ERROR;
+  }
+  if (rotate & SSD1306_ROTATE_180) {
+    commands[0] = SSD1306_SEG_REMAP;
+    commands[1] = SSD1306_COM_SCAN_DIR;
+  }
+  rotation = rotate;
+  // viewports of new orientation
+  // -------------------------------------------------------------------------------------
+  viewTop = 0;
+  views[0].x2 = (rotate & SSD1306_PORTRAIT) ? (MAX_Y - 1) : MAX_X;
+  views[0].y2 = (rotate & SSD1306_PORTRAIT) ? END_COLUMN_ADDR : (MAX_Y - 1);
+  SSD1306_ClipUpdate ();
+
+  return SSD1306_Commands (address, commands, 2);
+}
+
+/**
+ * @brief   SSD1306 Rotation get
+ *
+ * @param   void
+ *
+ * @return  uint8_t SSD1306_ROTATE_0 ... SSD1306_ROTATE_270
+ */
+uint8_t SSD1306_GetRotation (void)
+{
+  return rotation;
+}
+
+/**
+ * @brief   SSD1306 Rotate 8x8 block by 90 degrees - columns (page bytes, LSB on top)
+ *          of landscape block become columns of portrait block in panel format:
+ *          out[r] bit b = in[7 - b] bit r. All eight rows are kept in registers and
+ *          every source column is shifted into them once (no 32-bit shifts on AVR).
+ *
+ * @param   const uint8_t * columns in PROGMEM
+ * @param   uint8_t number of columns -> 1 ... 8, missing columns are blank
+ * @param   uint8_t * out - 8 bytes
+ *
+ * @return  void
+ */
+void SSD1306_Rotate8_P (const uint8_t * in, uint8_t columns, uint8_t * out)
+{
+  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0, r6 = 0, r7 = 0;
+  uint8_t shift = 8 - columns;
+  uint8_t column;
+
+  while (columns--) {
+    column = pgm_read_byte (in++);
+    r0 = (r0 << 1) | (column & 0x01); column >>= 1;
+    r1 = (r1 << 1) | (column & 0x01); column >>= 1;
+    r2 = (r2 << 1) | (column & 0x01); column >>= 1;
+    r3 = (r3 << 1) | (column & 0x01); column >>= 1;
+    r4 = (r4 << 1) | (column & 0x01); column >>= 1;
+    r5 = (r5 << 1) | (column & 0x01); column >>= 1;
+    r6 = (r6 << 1) | (column & 0x01); column >>= 1;
+    r7 = (r7 << 1) | column;
+  }
+  out[0] = r0 << shift;
+  out[1] = r1 << shift;
+  out[2] = r2 << shift;
+  out[3] = r3 << shift;
+  out[4] = r4 << shift;
+  out[5] = r5 << shift;
+  out[6] = r6 << shift;
+  out[7] = r7 << shift;
+}
+
+/**
+ * @brief   SSD1306 Update screen - failed transfer is retried up to SSD1306_RETRIES
+ *          times, every retry re-addresses the window from the first page that was
+ *          not completely acknowledged, pages already written are not sent again
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint8_t
+ */
+uint8_t SSD1306_UpdateScreen (uint8_t address)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t retries = SSD1306_RETRIES;
+  uint8_t page = START_PAGE_ADDR;                                 // first page not acked
+  uint8_t last;
+  SSD1306_STATS_FLUSH_BEGIN ()
+
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_UPDATE);
+  flushCleared = 0;
+  while (page <= END_PAGE_ADDR) {
+    // sparse cache: blank page already blank on display is skipped, window ends
+    // before the next skipped page
+    // -----------------------------------------------------------------------------------
+    if (SSD1306_CACHE_SKIP (page)) {
+      page++;
+      continue;
+    }
+    last = page;
+    while ((last < END_PAGE_ADDR) && !SSD1306_CACHE_SKIP (last + 1)) {
+      last++;
+    }
+    // TWI: start & SLAW
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_StartAndSLAW (address);
+    // retry - NOPs complete arguments of command interrupted by previous attempt
+    // -----------------------------------------------------------------------------------
+    if ((SSD1306_SUCCESS == status) && (retries < SSD1306_RETRIES)) {
+      status = SSD1306_Send_Command (SSD1306_NOP);
+      if (SSD1306_SUCCESS == status) {
+        status = SSD1306_Send_Command (SSD1306_NOP);
+      }
+    }
+    // window from the first page not acked, bitmaps may have left a smaller one
+    // -----------------------------------------------------------------------------------
+    if (SSD1306_SUCCESS == status) {
+      status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, page, last);
+    }
+    // control byte data stream
+    // -----------------------------------------------------------------------------------
+    if (SSD1306_SUCCESS == status) {
+      status = SSD1306_Send_DataStream ();
+    }
+    //  send cache memory lcd page by page
+    // -----------------------------------------------------------------------------------
+    while ((SSD1306_SUCCESS == status) && (page <= last)) {
+      status = SSD1306_Send_Frame (page << 7, END_COLUMN_ADDR + 1);
+      if (SSD1306_SUCCESS == status) {
+        SSD1306_CACHE_SENT (page);
+        page++;                                                   // page acked
+      }
+    }
+    // stop TWI
+    // -----------------------------------------------------------------------------------
+    if (SSD1306_SUCCESS == status) {
+      SSD1306_Send_Stop ();
+      continue;
+    }
+    // bus already released, retry
+    // -----------------------------------------------------------------------------------
+    if (0 == retries--) {
+      SSD1306_FrameEnd ();                                        // frame dropped
+      SSD1306_PROBE_END (SSD1306_PROBE_UPDATE);
+      return status;
+    }
+    SSD1306_STATS_INC (retries);
+  }
+  SSD1306_FrameEnd ();
+  SSD1306_STATS_FLUSH_END ()
+  SSD1306_PROBE_END (SSD1306_PROBE_UPDATE);
+
+  return SSD1306_SUCCESS;
+}
+
+#if SSD1306_USE_ASYNC
+/**
+ * @brief   SSD1306 Update step - incremental flush for cooperative main loops, sends at
+ *          most 'bytes' bus bytes (data & SSD1306_STEP_OVERHEAD per re-addressing)
+ *          and returns. Position is kept across calls, every call starts a new
+ *          transaction with the window set from the saved page / column:
+ *            column 0   - window to the end of screen, pages follow by wrap
+ *            column > 0 - window to the end of page, rest by repeated START
+ *          Cache memory changed during frame is sent as it is at the time of the step.
+ *          Deferred commands of display are charged to the budget (2 bytes each) and
+ *          wait for a step with room for them and data.
  *
  * @param   uint8_t address
+ * @param   uint16_t budget in bytes, SSD1306_CYCLES_TO_BYTES (cycles) for time budget
  *
- * @return  uint8_t
+ * @return  uint8_t SSD1306_SUCCESS frame complete, SSD1306_STEP_PENDING more to send
  */
-uint8_t SSD1306_Init (uint8_t address)
-{ 
-  const uint8_t * list = INIT_SSD1306;
-  uint8_t status = INIT_STATUS;                                   // init status
-  uint8_t arguments;
-  uint8_t commands = pgm_read_byte (list++);
+uint8_t SSD1306_UpdateStep (uint8_t address, uint16_t bytes)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t started = 0;
+  uint8_t column;
+  uint8_t page;
+  uint16_t length;
+  uint16_t queued = SSD1306_Queued (address) << 1;                // control byte & command
+  uint8_t hold = 0;
 
-  // TWI: Init
-  // -------------------------------------------------------------------------------------
-  TWI_Init ();
-  // TWI: start & SLAW
-  // -------------------------------------------------------------------------------------
-  status = SSD1306_Send_StartAndSLAW (address);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+  if (0 == stepPos) {
+    flushCleared = 0;                                             // frame start
   }
-  // Commands & Arguments
-  // -------------------------------------------------------------------------------------
-  while (commands--) {
-    // Command
+  if (bytes <= (SSD1306_STEP_OVERHEAD + queued)) {
+    queued = 0;                                                   // no room, postponed
+    hold = 1;
+  }
+  while ((stepPos < CACHE_SIZE_MEM) && (bytes > (SSD1306_STEP_OVERHEAD + queued))) {
+    bytes -= SSD1306_STEP_OVERHEAD + queued;
+    queued = 0;                                                   // sent by first window
+    page = stepPos >> 7;                                          // stepPos / 128
+    column = stepPos & END_COLUMN_ADDR;                           // stepPos % 128
+    // TWI: (repeated) start & SLAW
     // -----------------------------------------------------------------------------------
-    status = SSD1306_Send_Command (pgm_read_byte(list++));
+    status = SSD1306_Send_StartAndSLAW (address);
     if (SSD1306_SUCCESS != status) {
       return status;
     }
-    // Arguments
+    started = 1;
+    // window from saved position
     // -----------------------------------------------------------------------------------
-    arguments = pgm_read_byte (list++);
-    while (arguments--) {
-      status = SSD1306_Send_Command (pgm_read_byte(list++));  // argument
-      if (SSD1306_SUCCESS != status) {
-        return status;
-      }
+    cmdHold = hold;
+    if (column) {
+      status = SSD1306_Send_Window (column, END_COLUMN_ADDR, page, page);
+      length = (END_COLUMN_ADDR + 1) - column;
+    } else {
+      status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, page, END_PAGE_ADDR);
+      length = CACHE_SIZE_MEM - stepPos;
+    }
+    cmdHold = 0;
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+    // control byte data stream
+    // -----------------------------------------------------------------------------------
+    status = SSD1306_Send_DataStream ();
+    if (SSD1306_SUCCESS != status) {
+      return status;
+    }
+    // data within budget
+    // -----------------------------------------------------------------------------------
+    if (length > bytes) {
+      length = bytes;
+    }
+    status = SSD1306_Send_Frame (stepPos, length);
+    if (SSD1306_SUCCESS != status) {
+      return status;                                              // resent next call
+    }
+#if defined(SSD1306_SPARSE)
+    // pages sent whole by this transfer, page split between calls stays unknown
+    // -----------------------------------------------------------------------------------
+    for (page = (stepPos + END_COLUMN_ADDR) >> 7; page < ((stepPos + length) >> 7); page++) {
+      SSD1306_CACHE_SENT (page);
     }
+#endif
+    stepPos += length;
+    bytes -= length;
   }
-  // TWI: Stop
+  // stop TWI
   // -------------------------------------------------------------------------------------
-  TWI_Stop ();
+  if (started) {
+    SSD1306_Send_Stop ();
+  }
+  // frame complete
+  // -------------------------------------------------------------------------------------
+  if (stepPos >= CACHE_SIZE_MEM) {
+    stepPos = 0;
+    SSD1306_FrameEnd ();
+    return SSD1306_SUCCESS;
+  }
 
-  return SSD1306_SUCCESS;
+  return SSD1306_STEP_PENDING;
 }
 
 /**
- * @brief   SSD1306 Send Start and SLAW request
+ * @brief   SSD1306 Update progress - bytes of current frame already sent by
+ *          SSD1306_UpdateStep, 0 if no frame in progress
  *
- * @param   uint8_t
+ * @param   void
+ *
+ * @return  uint16_t 0 ... CACHE_SIZE_MEM - 1
+ */
+uint16_t SSD1306_UpdateProgress (void)
+{
+  return stepPos;
+}
+
+/**
+ * @brief   SSD1306 Update screen on shared bus - flush is split by SSD1306_UpdateStep
+ *          into chunks of SSD1306_SHARED_CHUNK bus bytes, each closed by STOP, and
+ *          pending transactions of TWI scheduler clients run between them
+ *
+ * @param   uint8_t address
  *
  * @return  uint8_t
  */
-uint8_t SSD1306_Send_StartAndSLAW (uint8_t address)
+uint8_t SSD1306_UpdateShared (uint8_t address)
 {
   uint8_t status = INIT_STATUS;
 
-  // TWI: start
-  // -------------------------------------------------------------------------------------
-  status = TWI_MT_Start ();
-  if (SSD1306_SUCCESS != status) {
-    return status;
-  }
-  // TWI: send SLAW
-  // -------------------------------------------------------------------------------------
-  status = TWI_MT_Send_SLAW (address);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+  while (SSD1306_STEP_PENDING == (status = SSD1306_UpdateStep (address, SSD1306_SHARED_CHUNK))) {
+    TWI_SchedYield ();
   }
+  // clients requested during last chunk
+  TWI_SchedYield ();
 
-  return SSD1306_SUCCESS;
+  return status;
 }
 
 /**
- * @brief   SSD1306 Send command
+ * @brief   SSD1306 Stream start - see SSD1306_StreamBuffer
  *
- * @param   uint8_t command
+ * @param   uint8_t address - SSD1306_SPI | CS pin
+ * @param   uint8_t * buffer - CACHE_SIZE_MEM bytes
+ * @param   uint8_t clear - 1 bytes are zeroed by SPI interrupt once sent
  *
  * @return  uint8_t
  */
-uint8_t SSD1306_Send_Command (uint8_t command)
+static uint8_t SSD1306_StreamStart (uint8_t address, uint8_t * buffer, uint8_t clear)
 {
   uint8_t status = INIT_STATUS;
 
-  // send control byte
-  // -------------------------------------------------------------------------------------   
-  status = TWI_MT_Send_Data (SSD1306_COMMAND);
+#if defined(SPI_HARDWARE)
+  if (!(address & SSD1306_SPI)) {
+    return SSD1306_ERROR;                                         // TWI not supported
+  }
+  // SPI: chip select
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_StartAndSLAW (address);
   if (SSD1306_SUCCESS != status) {
     return status;
   }
-  // send command
-  // -------------------------------------------------------------------------------------   
-  status = TWI_MT_Send_Data (command);
+  // full screen window
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (START_COLUMN_ADDR, END_COLUMN_ADDR, START_PAGE_ADDR, END_PAGE_ADDR);
   if (SSD1306_SUCCESS != status) {
     return status;
   }
+  // data, chip select released at the end of stream
+  // -------------------------------------------------------------------------------------
+  SSD1306_Send_DataStream ();
+  SSD1306_TRACE_EVENT_BUFFER (buffer, CACHE_SIZE_MEM, 0);
+  SSD1306_TRACE_EVENT_STOP ();
+  if (clear) {
+    SPI_StreamClear (buffer, CACHE_SIZE_MEM, address & SSD1306_SPI_CS);
+  } else {
+    SPI_Stream (buffer, CACHE_SIZE_MEM, address & SSD1306_SPI_CS);
+  }
 
   return SSD1306_SUCCESS;
+#else
+  (void) address;
+  (void) buffer;
+  (void) clear;
+  (void) status;
+
+  return SSD1306_ERROR;
+#endif
 }
 
 /**
- * +------------------------------------------------------------------------------------+
- * |== PUBLIC FUNCTIONS ================================================================|
- * +------------------------------------------------------------------------------------+
+ * @brief   SSD1306 Stream buffer - SPI only, full screen of page data is sent by SPI
+ *          interrupt (SPI_STREAM defined) and function returns right after window is
+ *          set. Buffer must not be changed till SPI_StreamBusy () returns 0, next
+ *          transaction waits for the stream automatically.
+ *
+ * @param   uint8_t address - SSD1306_SPI | CS pin
+ * @param   const uint8_t * buffer - CACHE_SIZE_MEM bytes
+ *
+ * @return  uint8_t
  */
+uint8_t SSD1306_StreamBuffer (uint8_t address, const uint8_t * buffer)
+{
+  return SSD1306_StreamStart (address, (uint8_t *) buffer, 0);    // not written
+}
 
 /**
- * @brief   SSD1306 Normal colors
+ * @brief   SSD1306 Stream screen - SPI only, cache memory is sent by SPI interrupt,
+ *          see SSD1306_StreamBuffer, flush mode clear zeroes every byte once sent,
+ *          not available with sparse cache
  *
- * @param   uint8_t address
+ * @param   uint8_t address - SSD1306_SPI | CS pin
  *
  * @return  uint8_t
  */
-uint8_t SSD1306_NormalScreen (uint8_t address)
+uint8_t SSD1306_StreamScreen (uint8_t address)
+{
+#if defined(SSD1306_SPARSE)
+  (void) address;
+
+  return SSD1306_ERROR;                                           // pages not contiguous
+#else
+  return SSD1306_StreamStart (address, (uint8_t *) cacheMemLcd, SSD1306_FLUSH_CLEAR == flushMode);
+#endif
+}
+#endif
+
+/**
+ * @brief   SSD1306 Probe maximal TWI SCL frequency - raises SCL step by step and sends
+ *          NOP commands until NACK or bus error shows up, then backs off to the last
+ *          step that passed all rounds. Panel can't be read back over TWI, so
+ *          corrupted transfers are seen only as wrong status.
+ *
+ * @param   uint8_t address
+ *
+ * @return  uint32_t SCL frequency set in Hz, 0 if no step passed (TWI_SCL_FREQ set)
+ */
+uint32_t SSD1306_ProbeSpeed (uint8_t address)
 {
   uint8_t status = INIT_STATUS;
+  uint32_t best = 0;
+  uint32_t freq;
+  uint8_t step;
+  uint8_t round;
+  uint8_t i;
 
-  // TWI: start & SLAW
+  TWI_Init ();
+  for (step = 0; step < (sizeof (SSD1306_PROBE_STEPS) / sizeof (uint16_t)); step++) {
+    freq = TWI_SetFreq (pgm_read_word (&SSD1306_PROBE_STEPS[step]) * 1000UL);
+    if (0 == freq) {                                              // above F_CPU / 16
+      break;
+    }
+    for (round = 0; round < SSD1306_PROBE_ROUNDS; round++) {
+      status = SSD1306_Send_StartAndSLAW (address);
+      for (i = 0; (SSD1306_SUCCESS == status) && (i < SSD1306_PROBE_NOPS); i++) {
+        status = SSD1306_Send_Command (SSD1306_NOP);
+      }
+      if (SSD1306_SUCCESS != status) {
+        break;                                                    // bus released
+      }
+      SSD1306_Send_Stop ();
+    }
+    if (SSD1306_SUCCESS != status) {
+      break;
+    }
+    best = pgm_read_word (&SSD1306_PROBE_STEPS[step]) * 1000UL;
+  }
+  // back off
   // -------------------------------------------------------------------------------------
-  status = SSD1306_Send_StartAndSLAW (address);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+  if (0 == best) {
+    TWI_Init ();
+    return 0;
   }
-  // send command
-  // -------------------------------------------------------------------------------------   
-  status = SSD1306_Send_Command (SSD1306_DIS_NORMAL);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+
+  return TWI_SetFreq (best);
+}
+
+/**
+ * @brief   SSD1306 Clear screen
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_ClearScreen (void)
+{
+#if defined(SSD1306_LAYERS)
+  if (cacheTarget) {
+    memset (cacheTarget, CLEAR_COLOR, cacheTargetPages << 7);     // layer buffer
+    return;
   }
-  // TWI: Stop
+#endif
+#if defined(SSD1306_SPARSE)
+  memset (cacheSlot, 0, sizeof (cacheSlot));                      // all pages back to pool
+#else
+  memset (cacheMemLcd, 0x00, CACHE_SIZE_MEM);                     // null cache memory lcd
+#endif
+  SSD1306_STATS_DRAW (CACHE_SIZE_MEM);
+}
+
+/**
+ * @brief   SSD1306 Push viewport - origin & clip rectangle relative to current
+ *          viewport, clip is intersection with it, all primitives are translated
+ *          by origin and clipped
+ *
+ * @param   uint8_t x - origin relative to current viewport
+ * @param   uint8_t y
+ * @param   uint8_t width
+ * @param   uint8_t height
+ *
+ * @return  uint8_t SSD1306_ERROR if stack full or nothing visible
+ */
+uint8_t SSD1306_PushViewport (uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+  const SSD1306_View * parent = &views[viewTop];
+  SSD1306_View * view = &views[viewTop + 1];
+  uint16_t x1 = parent->ox + x;
+  uint16_t y1 = parent->oy + y;
+  uint16_t x2 = x1 + w - 1;
+  uint16_t y2 = y1 + h - 1;
+
+  if (((viewTop + 1) >= SSD1306_VIEWPORTS) || (0 == w) || (0 == h)) {
+    return SSD1306_ERROR;
+  }
+  // intersection with parent
   // -------------------------------------------------------------------------------------
-  TWI_Stop ();
+  if ((x1 > parent->x2) || (y1 > parent->y2) || (x2 < parent->x1) || (y2 < parent->y1)) {
+    return SSD1306_ERROR;                                         // nothing visible
+  }
+  view->ox = x1;
+  view->oy = y1;
+  view->x1 = (x1 < parent->x1) ? parent->x1 : x1;
+  view->y1 = (y1 < parent->y1) ? parent->y1 : y1;
+  view->x2 = (x2 > parent->x2) ? parent->x2 : x2;
+  view->y2 = (y2 > parent->y2) ? parent->y2 : y2;
+  viewTop++;
+  SSD1306_ClipUpdate ();
 
   return SSD1306_SUCCESS;
 }
 
 /**
- * @brief   SSD1306 Inverse colors
+ * @brief   SSD1306 Pop viewport
  *
- * @param   uint8_t address
+ * @param   void
  *
- * @return  uint8_t
+ * @return  uint8_t SSD1306_ERROR if full screen already
  */
-uint8_t SSD1306_InverseScreen (uint8_t address)
+uint8_t SSD1306_PopViewport (void)
 {
-  uint8_t status = INIT_STATUS;
-
-  // TWI: start & SLAW
-  // -------------------------------------------------------------------------------------
-  status = SSD1306_Send_StartAndSLAW (address);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+  if (0 == viewTop) {
+    return SSD1306_ERROR;
   }
-  // send command
-  // -------------------------------------------------------------------------------------   
-  status = SSD1306_Send_Command (SSD1306_DIS_INVERSE);
-  if (SSD1306_SUCCESS != status) {
-    return status;
+  viewTop--;
+  SSD1306_ClipUpdate ();
+
+  return SSD1306_SUCCESS;
+}
+
+/**
+ * @brief   SSD1306 Viewport area - translates area of block primitive (bitmap, page
+ *          blitter) by origin, block is drawn only if it fits inside clip
+ *
+ * @param   uint8_t * x -> translated to screen
+ * @param   uint8_t * y -> translated to screen
+ * @param   uint8_t width
+ * @param   uint8_t height
+ *
+ * @return  uint8_t SSD1306_ERROR if area is not inside clip
+ */
+uint8_t SSD1306_ViewportArea (uint8_t * x, uint8_t * y, uint8_t w, uint8_t h)
+{
+  const SSD1306_View * view = &views[viewTop];
+  uint16_t x1 = view->ox + *x;
+  uint16_t y1 = view->oy + *y;
+
+  if ((0 == w) || (0 == h) ||
+      (x1 < view->x1) || ((x1 + w - 1) > view->x2) ||
+      (y1 < view->y1) || ((y1 + h - 1) > view->y2)) {
+    return SSD1306_ERROR;
   }
-  // TWI: Stop
-  // -------------------------------------------------------------------------------------
-  TWI_Stop ();
+  *x = x1;
+  *y = y1;
 
   return SSD1306_SUCCESS;
 }
 
 /**
- * @brief   SSD1306 Update screen
+ * @brief   SSD1306 Update viewport - only pages & columns under clip of current
+ *          viewport are sent in one transaction, sparse cache: sent page is marked
+ *          blank on display if it is blank in cache and outside of clip too
  *
  * @param   uint8_t address
  *
  * @return  uint8_t
  */
-uint8_t SSD1306_UpdateScreen (uint8_t address)
+uint8_t SSD1306_UpdateViewport (uint8_t address)
 {
   uint8_t status = INIT_STATUS;
-  uint16_t i = 0;
+  uint8_t page = clipRow1 >> 3;
+#if defined(SSD1306_SPARSE)
+  uint8_t blank = cacheBlank;                                     // display RAM before window
+  uint8_t whole = (START_COLUMN_ADDR == clipCol1) && (END_COLUMN_ADDR == clipCol2);
+#endif
 
   // TWI: start & SLAW
   // -------------------------------------------------------------------------------------
@@ -279,52 +1759,114 @@ uint8_t SSD1306_UpdateScreen (uint8_t address)
   if (SSD1306_SUCCESS != status) {
     return status;
   }
+  // window of clip
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_Window (clipCol1, clipCol2, page, clipRow2 >> 3);
+  if (SSD1306_SUCCESS != status) {
+    return status;
+  }
   // control byte data stream
-  // -------------------------------------------------------------------------------------   
-  status = TWI_MT_Send_Data (SSD1306_DATA_STREAM);
+  // -------------------------------------------------------------------------------------
+  status = SSD1306_Send_DataStream ();
   if (SSD1306_SUCCESS != status) {
     return status;
   }
-  //  send cache memory lcd
+  // columns of clip page by page
   // -------------------------------------------------------------------------------------
-  while (i < CACHE_SIZE_MEM) {
-    status = TWI_MT_Send_Data (cacheMemLcd[i++]);                 // send data
+  while (page <= (clipRow2 >> 3)) {
+    status = SSD1306_Send_Cache ((page << 7) + clipCol1, clipCol2 - clipCol1 + 1);
     if (SSD1306_SUCCESS != status) {
       return status;
     }
+#if defined(SSD1306_SPARSE)
+    // columns out of clip are known only if page was blank on display before
+    if (whole || (blank & (1 << page))) {
+      SSD1306_CACHE_SENT (page);
+    }
+#endif
+    page++;
   }
   // stop TWI
   // -------------------------------------------------------------------------------------
-  TWI_Stop ();
+  SSD1306_Send_Stop ();
 
   return SSD1306_SUCCESS;
 }
 
+#if SSD1306_USE_TEXT
 /**
- * @brief   SSD1306 Clear screen
+ * @brief   SSD1306 Set position - relative to current viewport
  *
- * @param   void
+ * @param   uint8_t column -> 0 ... 127 
+ * @param   uint8_t page -> 0 ... 7 or 3 
  *
  * @return  void
  */
-void SSD1306_ClearScreen (void)
+void SSD1306_SetPosition (uint8_t x, uint8_t y) 
 {
-  memset (cacheMemLcd, 0x00, CACHE_SIZE_MEM);                     // null cache memory lcd
+  x += views[viewTop].ox;                                         // viewport origin
+  y += views[viewTop].oy >> 3;
+  if (rotation & SSD1306_PORTRAIT) {                              // panel column y * 8,
+    _counter = (y << 3) + ((END_PAGE_ADDR - (x >> 3)) << 7);      // page from right
+    return;
+  }
+  _counter = x + (y << 7);                                        // update counter
 }
+#endif
 
 /**
- * @brief   SSD1306 Set position
+ * @brief   SSD1306 Cache memory page - for blitters writing page data directly,
+ *          sparse cache allocates blank page from pool
  *
- * @param   uint8_t column -> 0 ... 127 
- * @param   uint8_t page -> 0 ... 7 or 3 
+ * @param   uint8_t page -> 0 ... 7 or 3
+ *
+ * @return  uint8_t * first column of page, NULL if out of range or pool exhausted
+ */
+uint8_t * SSD1306_CachePage (uint8_t page)
+{
+  if (page > END_PAGE_ADDR) {                                     // if out of range
+    return NULL;
+  }
+
+  return SSD1306_CacheByte (page << 7, 1);                        // page * 128
+}
+
+#if defined(SSD1306_LAYERS)
+/**
+ * @brief   SSD1306 Cache target - primitives draw into buffer of full width pages
+ *          instead of cache memory, page 0 of buffer is page 0 of drawing,
+ *          bytes out of buffer are dropped
+ *
+ * @param   uint8_t * buffer, NULL back to cache memory
+ * @param   uint8_t pages
  *
  * @return  void
  */
-void SSD1306_SetPosition (uint8_t x, uint8_t y) 
+void SSD1306_CacheTarget (uint8_t * buffer, uint8_t pages)
 {
-  _counter = x + (y << 7);                                        // update counter
+  cacheTarget = buffer;
+  cacheTargetPages = pages;
+}
+#endif
+
+/**
+ * @brief   SSD1306 Cache memory page for reading, nothing is allocated
+ *
+ * @param   uint8_t page -> 0 ... 7 or 3
+ *
+ * @return  const uint8_t * first column of page, NULL if out of range or blank page
+ *                          of sparse cache (reads as zero)
+ */
+const uint8_t * SSD1306_CacheRead (uint8_t page)
+{
+  if (page > END_PAGE_ADDR) {                                     // if out of range
+    return NULL;
+  }
+
+  return SSD1306_CacheByte (page << 7, 0);                        // page * 128
 }
 
+#if SSD1306_USE_TEXT
 /**
  * @brief   SSD1306 Update text poisition - this ensure that character will not be divided at the end of row, 
  *          the whole character will be depicted on the new row
@@ -339,17 +1881,46 @@ uint8_t SSD1306_UpdatePosition (void)
   uint8_t x = _counter - (y << 7);                                // y % 8
   uint8_t x_new = x + CHARS_COLS_LENGTH + 1;                      // x + character length + 1
   
-  if (x_new > END_COLUMN_ADDR) {                                  // check position
+  if (x_new > clipCol2) {                                         // check position against clip
     if (y > END_PAGE_ADDR) {                                      // if more than allowable number of pages
       return SSD1306_ERROR;                                       // return out of range
-    } else if (y < (END_PAGE_ADDR-1)) {                           // if x reach the end but page in range
-      _counter = ((++y) << 7);                                    // update
+    } else if (y < (clipRow2 >> 3)) {                             // if x reach the end but page in clip
+      _counter = ((++y) << 7) + clipCol1;                         // update
     }
   }
  
   return SSD1306_SUCCESS;
 }
 
+/**
+ * @brief   SSD1306 Draw character in portrait - glyph rotated as one 8x8 block and
+ *          written as 8 whole bytes into one page, next character goes one page up,
+ *          after page 0 next text row starts 8 columns right
+ *
+ * @param   char character
+ *
+ * @return  uint8_t
+ */
+static uint8_t SSD1306_DrawCharPortrait (char character)
+{
+  uint8_t status = INIT_STATUS;
+  uint8_t glyph[8];
+
+  if (_counter >= CACHE_SIZE_MEM) {
+    return SSD1306_ERROR;                                         // out of range
+  }
+  SSD1306_Rotate8_P (FONTS[character-32], CHARS_COLS_LENGTH, glyph);
+  status = SSD1306_PutColumns (_counter, glyph, 8);               // clipped
+  if (_counter < (END_COLUMN_ADDR + 1)) {                         // page 0, next row
+    _counter += (END_PAGE_ADDR << 7) + 8;
+  } else {
+    _counter -= (END_COLUMN_ADDR + 1);                            // page up
+  }
+  SSD1306_STATS_DRAW (8);
+
+  return status;
+}
+
 /**
  * @brief   SSD1306 Draw character
  *
@@ -359,17 +1930,25 @@ uint8_t SSD1306_UpdatePosition (void)
  */
 uint8_t SSD1306_DrawChar (char character)
 {
+  uint8_t status = INIT_STATUS;
+  uint8_t glyph[CHARS_COLS_LENGTH];
   uint8_t i = 0;
 
+  if (rotation & SSD1306_PORTRAIT) {
+    return SSD1306_DrawCharPortrait (character);
+  }
   if (SSD1306_UpdatePosition () == SSD1306_ERROR) {
     return SSD1306_ERROR;
   }
   while (i < CHARS_COLS_LENGTH) {
-    cacheMemLcd[_counter++] = pgm_read_byte(&FONTS[character-32][i++]);
+    glyph[i] = pgm_read_byte(&FONTS[character-32][i]);
+    i++;
   }
-  _counter++;
+  status = SSD1306_PutColumns (_counter, glyph, CHARS_COLS_LENGTH);  // clipped
+  _counter += CHARS_COLS_LENGTH + 1;
+  SSD1306_STATS_DRAW (CHARS_COLS_LENGTH);
 
-  return SSD1306_SUCCESS;
+  return status;
 }
 
 /**
@@ -382,37 +1961,40 @@ uint8_t SSD1306_DrawChar (char character)
 void SSD1306_DrawString (char *str)
 {
   int i = 0;
+
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_STRING);
   while (str[i] != '\0') {
     SSD1306_DrawChar (str[i++]);
   }
+  SSD1306_PROBE_END (SSD1306_PROBE_STRING);
 }
+#endif
 
+#if SSD1306_USE_GRAPHICS
 /**
- * @brief   Draw pixel
+ * @brief   Draw pixel - relative to current viewport
  *
  * @param   uint8_t x -> 0 ... MAX_X
- * @param   uint8_t y -> 0 ... MAX_Y
+ * @param   uint8_t y -> 0 ... MAX_Y - 1
  *
  * @return  uint8_t
  */
 uint8_t SSD1306_DrawPixel (uint8_t x, uint8_t y)
 {
-  uint8_t page = 0;
-  uint8_t pixel = 0;
-  
-  if ((x > MAX_X) || (y > MAX_Y)) {                               // if out of range
-    return SSD1306_ERROR;                                         // out of range
+  const SSD1306_View * view = &views[viewTop];
+  uint16_t lx = view->ox + x;
+  uint16_t ly = view->oy + y;
+
+  if ((lx < view->x1) || (lx > view->x2) || (ly < view->y1) || (ly > view->y2)) {
+    return SSD1306_ERROR;                                         // outside clip
   }
-  page = y >> 3;                                                  // find page (y / 8)
-  pixel = 1 << (y - (page << 3));                                 // which pixel (y % 8)
-  _counter = x + (page << 7);                                     // update counter
-  cacheMemLcd[_counter++] |= pixel;                               // save pixel
 
-  return SSD1306_SUCCESS;
+  return SSD1306_PlotPixel (lx, ly);
 }
 
 /**
- * @brief   Draw line by Bresenham algoritm
+ * @brief   Draw line by Bresenham algoritm - relative to current viewport, clipped
+ *          once, pixels are not checked
  *  
  * @param   uint8_t x start position / 0 <= cols <= MAX_X-1
  * @param   uint8_t x end position   / 0 <= cols <= MAX_X-1
@@ -423,10 +2005,21 @@ uint8_t SSD1306_DrawPixel (uint8_t x, uint8_t y)
  */
 uint8_t SSD1306_DrawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
 {
+  const SSD1306_View * view = &views[viewTop];
+  int16_t line[4] = { view->ox + x1, view->oy + y1, view->ox + x2, view->oy + y2 };
   int16_t D;                                                      // determinant
   int16_t delta_x, delta_y;                                       // deltas
   int16_t trace_x = 1, trace_y = 1;                               // steps
 
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_LINE);
+  if (SSD1306_ClipLine (line) != SSD1306_SUCCESS) {               // clip to viewport
+    SSD1306_PROBE_END (SSD1306_PROBE_LINE);
+    return SSD1306_ERROR;                                         // outside
+  }
+  x1 = line[0];
+  y1 = line[1];
+  x2 = line[2];
+  y2 = line[3];
   delta_x = x2 - x1;                                              // delta x
   delta_y = y2 - y1;                                              // delta y
   
@@ -444,7 +2037,7 @@ uint8_t SSD1306_DrawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
   // -------------------------------------------------------------------------------------
   if (delta_y < delta_x) {
     D = (delta_y << 1) - delta_x;                                 // calculate determinant
-    SSD1306_DrawPixel (x1, y1);                                   // draw first pixel
+    SSD1306_PlotPixel (x1, y1);                                   // draw first pixel
     while (x1 != x2) {                                            // check if x1 equal x2
       x1 += trace_x;                                              // update x1
       if (D >= 0) {                                               // check if determinant is positive
@@ -452,13 +2045,13 @@ uint8_t SSD1306_DrawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
         D -= 2*delta_x;                                           // update determinant
       }
       D += 2*delta_y;                                             // update deteminant
-      SSD1306_DrawPixel (x1, y1);                                 // draw next pixel
+      SSD1306_PlotPixel (x1, y1);                                 // draw next pixel
     }
   // for m > 1 (dy > dx)    
   // -------------------------------------------------------------------------------------
   } else {
     D = delta_y - (delta_x << 1);                                 // calculate determinant
-    SSD1306_DrawPixel (x1, y1);                                   // draw first pixel
+    SSD1306_PlotPixel (x1, y1);                                   // draw first pixel
     while (y1 != y2) {                                            // check if y2 equal y1
       y1 += trace_y;                                              // update y1
       if (D <= 0) {                                               // check if determinant is positive
@@ -466,9 +2059,11 @@ uint8_t SSD1306_DrawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
         D += 2*delta_y;                                           // update determinant
       }
       D -= 2*delta_x;                                             // update deteminant
-      SSD1306_DrawPixel (x1, y1);                                 // draw next pixel
+      SSD1306_PlotPixel (x1, y1);                                 // draw next pixel
     }
   }
+  SSD1306_PROBE_END (SSD1306_PROBE_LINE);
 
   return SSD1306_SUCCESS;
-}
\ No newline at end of file
+}
+#endif
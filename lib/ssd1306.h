@@ -11,7 +11,7 @@
  * @version     2.0.0
  * @test        AVR Atmega328p
  *
- * @depend      string.h, font.h, twi.h
+ * @depend      string.h, config.h, font.h, twi.h, spi.h
  * -------------------------------------------------------------------------------------+
  * @brief       Version 1.0 -> applicable for 1 display
  *              Version 2.0 -> rebuild to 'cacheMemLcd' array
@@ -25,8 +25,30 @@
 
   // @includes
   #include <string.h>                     // memset function
-  #include "font.h"
+  #include "config.h"
   #include "twi.h"
+  #include "spi.h"
+  #include "trace.h"
+
+  // Font of text, SSD1306_FONT (config.h)
+  // ------------------------------------------------------------------------------------
+  #if SSD1306_USE_TEXT
+    #if (SSD1306_FONT == SSD1306_FONT_5X8)
+      #include "font5x8.h"
+      #define FONTS                 FONTS_5X8
+      #define CHARS_COLS_LENGTH     FONTS_5X8_COLS
+    #elif (SSD1306_FONT == SSD1306_FONT_6X8)
+      #include "font6x8.h"
+      #define FONTS                 FONTS_6X8
+      #define CHARS_COLS_LENGTH     FONTS_6X8_COLS
+    #elif (SSD1306_FONT == SSD1306_FONT_8X8)
+      #include "font8x8.h"
+      #define FONTS                 FONTS_8X8
+      #define CHARS_COLS_LENGTH     FONTS_8X8_COLS
+    #else
+      #include "font.h"
+    #endif
+  #endif
 
   // Success / Error
   // ------------------------------------------------------------------------------------
@@ -36,6 +58,10 @@
   // Address definition
   // ------------------------------------------------------------------------------------
   #define SSD1306_ADDR              0x3C
+  // SPI (4-wire) module - address is SSD1306_SPI | CS pin of SPI_CS_PORT
+  #define SSD1306_SPI               0x80
+  #define SSD1306_SPI_CS            0x07
+  #define SSD1306_SPI_ADDR          (SSD1306_SPI | SPI_SS)
 
   // Command definition
   // ------------------------------------------------------------------------------------
@@ -83,6 +109,63 @@
   // ------------------------------------------------------------------------------------
   #define CLEAR_COLOR               0x00
 
+  // SCL probe - test rounds per frequency step, NOP commands per round
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_PROBE_ROUNDS
+    #define SSD1306_PROBE_ROUNDS    4
+  #endif
+  #define SSD1306_PROBE_NOPS        16
+
+  // Retries of failed flush - worst case latency of SSD1306_UpdateScreen is bounded by
+  //   (1 + SSD1306_RETRIES) * (CACHE_SIZE_MEM + 16) * TWI_TIMEOUT polls (~6 cycles)
+  //   + SSD1306_RETRIES * bus recovery (~150us)
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_RETRIES
+    #define SSD1306_RETRIES         3
+  #endif
+
+  // Command mode - immediate: own transaction, deferred: queued till next flush
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_IMMEDIATE         0
+  #define SSD1306_DEFERRED          1
+  #ifndef SSD1306_QUEUE_SIZE
+    #define SSD1306_QUEUE_SIZE      16    // bytes of commands & arguments
+  #endif
+
+  // Flush mode - keep: cache memory kept, clear: cache memory zeroed by flush while it
+  // is sent, next frame is drawn from blank (immediate mode rendering)
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_FLUSH_KEEP        0
+  #define SSD1306_FLUSH_CLEAR       1
+
+  // Incremental flush - pending status, bus bytes of one re-addressing
+  // (START, SLA+W, window 6 x 2, data control byte), budget from cycles at real SCL
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_STEP_PENDING      2
+  #define SSD1306_STEP_OVERHEAD     15
+  #define SSD1306_CYCLES_TO_BYTES(CYCLES) ((CYCLES) / (9 * (F_CPU / TWI_SCL_REAL)))
+
+  // Shared bus flush - bus bytes of one chunk between TWI_SchedYield calls
+  // (64 bytes ~ 1.5ms at 400kHz, worst wait of a higher priority transaction)
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_SHARED_CHUNK
+    #define SSD1306_SHARED_CHUNK    64
+  #endif
+
+  // Rotation - 180 by segment / COM remap, 90 & 270 by software (portrait)
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_ROTATE_0          0
+  #define SSD1306_ROTATE_90         1
+  #define SSD1306_ROTATE_180        2
+  #define SSD1306_ROTATE_270        3
+  #define SSD1306_PORTRAIT          0x01  // rotation bit of 90 & 270
+
+  // Viewports - depth of stack including full screen
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_VIEWPORTS
+    #define SSD1306_VIEWPORTS       4
+  #endif
+
   // Init Status
   // ------------------------------------------------------------------------------------
   #define INIT_STATUS               0xFF
@@ -101,8 +184,18 @@
   #define MAX_X                     END_COLUMN_ADDR
   #define MAX_Y                     (END_PAGE_ADDR + 1) * 8
 
-  // @var set area
-  unsigned int _counter;
+  // Sparse cache (SSD1306_SPARSE) - page of cache memory is taken from pool of
+  // SSD1306_SPARSE_PAGES pages on first write of lit pixel, blank page reads as zero
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_SPARSE_PAGES
+    #define SSD1306_SPARSE_PAGES    3
+  #endif
+  #if defined(SSD1306_SPARSE) && (SSD1306_SPARSE_PAGES > (END_PAGE_ADDR + 1))
+    #error "SSD1306_SPARSE_PAGES larger than number of pages"
+  #endif
+
+  // @var set area (defined in ssd1306.c)
+  extern unsigned int _counter;
   
   /**
    * --------------------------------------------------------------------------------------------+
@@ -136,6 +229,74 @@
    * @return  uint8_t
    */
   uint8_t SSD1306_Send_Command (uint8_t);
+
+  /**
+   * @brief   SSD1306 Send data byte
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Data (uint8_t);
+
+  /**
+   * @brief   SSD1306 Send buffer from RAM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Buffer (const uint8_t *, uint16_t);
+
+  /**
+   * @brief   SSD1306 Send buffer from PROGMEM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Buffer_P (const uint8_t *, uint16_t);
+
+  /**
+   * @brief   SSD1306 Send data stream start
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_DataStream (void);
+
+  /**
+   * @brief   SSD1306 Send stop
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_Send_Stop (void);
+
+  /**
+   * @brief   SSD1306 Send window - column & page address range
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Window (uint8_t, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   SSD1306 Send deferred commands
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Send_Queue (void);
   
   /**
    * +------------------------------------------------------------------------------------+
@@ -143,6 +304,15 @@
    * +------------------------------------------------------------------------------------+
    */
 
+  /**
+   * @brief   SSD1306 Probe maximal TWI SCL frequency
+   *
+   * @param   uint8_t
+   *
+   * @return  uint32_t
+   */
+  uint32_t SSD1306_ProbeSpeed (uint8_t);
+
   /**
    * @brief   SSD1306 Clear screen
    *
@@ -152,6 +322,44 @@
    */
   void SSD1306_ClearScreen (void);
 
+  /**
+   * @brief   SSD1306 Command mode
+   *
+   * @param   uint8_t
+   *
+   * @return  void
+   */
+  void SSD1306_SetCommandMode (uint8_t);
+
+  /**
+   * @brief   SSD1306 Flush mode
+   *
+   * @param   uint8_t
+   *
+   * @return  void
+   */
+  void SSD1306_SetFlushMode (uint8_t);
+
+  /**
+   * @brief   SSD1306 Commands
+   *
+   * @param   uint8_t
+   * @param   const uint8_t *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_Commands (uint8_t, const uint8_t *, uint8_t);
+
+  /**
+   * @brief   SSD1306 Flush deferred commands
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_FlushCommands (uint8_t);
+
   /**
    * @brief   SSD1306 Normal colors
    *
@@ -170,6 +378,46 @@
    */
   uint8_t SSD1306_InverseScreen (uint8_t);
 
+  /**
+   * @brief   SSD1306 Contrast
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_SetContrast (uint8_t, uint8_t);
+
+  /**
+   * @brief   SSD1306 Rotation
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_SetRotation (uint8_t, uint8_t);
+
+  /**
+   * @brief   SSD1306 Rotation get
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_GetRotation (void);
+
+  /**
+   * @brief   SSD1306 Rotate 8x8 block from flash by 90 degrees
+   *
+   * @param   const uint8_t *
+   * @param   uint8_t
+   * @param   uint8_t *
+   *
+   * @return  void
+   */
+  void SSD1306_Rotate8_P (const uint8_t *, uint8_t, uint8_t *);
+
   /**
    * @brief   SSD1306 Update screen
    *
@@ -179,6 +427,65 @@
    */
   uint8_t SSD1306_UpdateScreen (uint8_t);
 
+  /**
+   * @brief   SSD1306 Update viewport - flush of clip rectangle only
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_UpdateViewport (uint8_t);
+
+  #if SSD1306_USE_ASYNC
+  /**
+   * @brief   SSD1306 Update step - incremental flush within budget
+   *
+   * @param   uint8_t
+   * @param   uint16_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_UpdateStep (uint8_t, uint16_t);
+
+  /**
+   * @brief   SSD1306 Update progress of incremental flush
+   *
+   * @param   void
+   *
+   * @return  uint16_t
+   */
+  uint16_t SSD1306_UpdateProgress (void);
+
+  /**
+   * @brief   SSD1306 Update screen on shared bus - chunks & TWI_SchedYield
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_UpdateShared (uint8_t);
+
+  /**
+   * @brief   SSD1306 Stream screen by SPI interrupt
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_StreamScreen (uint8_t);
+
+  /**
+   * @brief   SSD1306 Stream buffer by SPI interrupt
+   *
+   * @param   uint8_t
+   * @param   const uint8_t *
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_StreamBuffer (uint8_t, const uint8_t *);
+  #endif
+
+  #if SSD1306_USE_TEXT
   /**
    * @brief   SSD1306 Update text position
    *
@@ -187,7 +494,42 @@
    * @return  uint8_t
    */
   uint8_t SSD1306_UpdatePosition (void);
+  #endif
+
+  /**
+   * @brief   SSD1306 Push viewport
+   *
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_PushViewport (uint8_t, uint8_t, uint8_t, uint8_t);
+
+  /**
+   * @brief   SSD1306 Pop viewport
+   *
+   * @param   void
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_PopViewport (void);
 
+  /**
+   * @brief   SSD1306 Viewport area - translate & check area of primitive
+   *
+   * @param   uint8_t *
+   * @param   uint8_t *
+   * @param   uint8_t
+   * @param   uint8_t
+   *
+   * @return  uint8_t
+   */
+  uint8_t SSD1306_ViewportArea (uint8_t *, uint8_t *, uint8_t, uint8_t);
+
+  #if SSD1306_USE_TEXT
   /**
    * @brief   SSD1306 Set position
    *
@@ -197,7 +539,39 @@
    * @return  void
    */
   void SSD1306_SetPosition (uint8_t, uint8_t);
+  #endif
+
+  /**
+   * @brief   SSD1306 Cache memory page
+   *
+   * @param   uint8_t
+   *
+   * @return  uint8_t *
+   */
+  uint8_t * SSD1306_CachePage (uint8_t);
+
+  /**
+   * @brief   SSD1306 Cache memory page for reading
+   *
+   * @param   uint8_t
+   *
+   * @return  const uint8_t *
+   */
+  const uint8_t * SSD1306_CacheRead (uint8_t);
+
+  #if defined(SSD1306_LAYERS)
+  /**
+   * @brief   SSD1306 Cache target - draw into layer buffer
+   *
+   * @param   uint8_t *
+   * @param   uint8_t
+   *
+   * @return  void
+   */
+  void SSD1306_CacheTarget (uint8_t *, uint8_t);
+  #endif
 
+  #if SSD1306_USE_TEXT
   /**
    * @brief   SSD1306 Draw character
    *
@@ -215,7 +589,9 @@
    * @return  void
    */
   void SSD1306_DrawString (char *);
+  #endif
 
+  #if SSD1306_USE_GRAPHICS
   /**
    * @brief   Draw pixel
    *
@@ -237,5 +613,6 @@
    * @return  uint8_t
    */
   uint8_t SSD1306_DrawLine (uint8_t, uint8_t, uint8_t, uint8_t);
+  #endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,543 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 C++ front end - display specialized at compile time
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        ssd1306.hpp
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      ssd1306.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Header only, C++11 (avr-g++ -std=gnu++11 -fno-exceptions -fno-rtti).
+ *              Size, transport and font are template parameters, so the init table is
+ *              generated for the panel height, framebuffer is sized by width x height
+ *              and bounds, shifts and the transport are folded by compiler - nothing is
+ *              decided at run time. Uses only TWI / SPI drivers and font of the C
+ *              library, no cache memory of ssd1306.c is linked in.
+ *
+ *              Commands go in one command stream (control byte 0x00), framebuffer in
+ *              one data stream (0x40). Lines are not clipped, line or pixel out of
+ *              screen returns SSD1306_ERROR. No viewports, rotation, retries, stats.
+ *
+ *              bench/ and 'make bench' compare code size and cycles with the C API.
+ * -------------------------------------------------------------------------------------+
+ * @usage       static Ssd1306<128, 32, Ssd1306Twi<SSD1306_ADDR> > oled;
+ *
+ *              oled.init ();
+ *              oled.drawLine (0, 127, 4, 4);
+ *              oled.setPosition (7, 1);
+ *              oled.drawString ("SSD1306 OLED DRIVER");
+ *              oled.update ();
+ */
+
+#ifndef __SSD1306_HPP__
+#define __SSD1306_HPP__
+
+  // @includes
+  #include <stdint.h>
+  #include <string.h>
+  #include <avr/io.h>
+  #include <avr/pgmspace.h>
+  #include <avr/interrupt.h>
+  #include <util/delay.h>                 // C++ safe headers outside of extern "C"
+
+  extern "C" {
+    #include "ssd1306.h"
+  }
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== TRANSPORTS =======================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   TWI transport - stream is START, SLAW, control byte ... STOP, bus is
+   *          released on failure
+   */
+  template <uint8_t Address = SSD1306_ADDR>
+  struct Ssd1306Twi
+  {
+    static void init (void)
+    {
+      TWI_Init ();
+    }
+
+    static uint8_t begin (uint8_t control)
+    {
+      uint8_t status = TWI_MT_Start ();
+
+      if (SUCCESS == status) {
+        status = TWI_MT_Send_SLAW (Address);
+      }
+      if (SUCCESS == status) {
+        status = TWI_MT_Send_Data (control);
+      }
+      return abort (status);
+    }
+
+    static uint8_t write (const uint8_t * buffer, uint16_t length)
+    {
+      return abort (TWI_MT_Send_Buffer (buffer, length));
+    }
+
+    static uint8_t write_P (const uint8_t * list, uint16_t length)
+    {
+      return abort (TWI_MT_Send_Buffer_P (list, length));
+    }
+
+    static void end (void)
+    {
+      TWI_Stop ();
+    }
+
+    // same as SSD1306_Abort - stuck bus recovered by bit-bang (SCL rate kept), NACK only stopped
+    static uint8_t abort (uint8_t status)
+    {
+      if (SUCCESS == status) {
+        return SSD1306_SUCCESS;
+      }
+      if (TWI_ERR_TIMEOUT == status) {
+        TWI_BusRecovery ();
+      } else {
+        TWI_Stop ();
+      }
+      return status;
+    }
+  };
+
+#if defined(SPI_HARDWARE)
+  /**
+   * @brief   SPI (4-wire) transport - stream is D/C level & chip select ... deselect
+   */
+  template <uint8_t Cs = SPI_SS>
+  struct Ssd1306Spi
+  {
+    static void init (void)
+    {
+      SPI_Init ();
+      SPI_CS_DDR |= (1 << Cs);
+      SPI_DESELECT (Cs);
+      SPI_Reset ();
+    }
+
+    static uint8_t begin (uint8_t control)
+    {
+      if (SSD1306_DATA_STREAM == control) {
+        SPI_DC_DATA ();
+      } else {
+        SPI_DC_COMMAND ();
+      }
+      SPI_SELECT (Cs);
+      return SSD1306_SUCCESS;
+    }
+
+    static uint8_t write (const uint8_t * buffer, uint16_t length)
+    {
+      SPI_Send_Buffer (buffer, length);
+      return SSD1306_SUCCESS;
+    }
+
+    static uint8_t write_P (const uint8_t * list, uint16_t length)
+    {
+      SPI_Send_Buffer_P (list, length);
+      return SSD1306_SUCCESS;
+    }
+
+    static void end (void)
+    {
+      SPI_DESELECT (Cs);
+    }
+  };
+#endif
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== FONTS ===========================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+#if SSD1306_USE_TEXT
+  /**
+   * @brief   Font of the C library (SSD1306_FONT), characters from 0x20
+   */
+  struct Ssd1306Font
+  {
+    static constexpr uint8_t Width = CHARS_COLS_LENGTH;
+
+    static uint8_t column (char character, uint8_t i)
+    {
+      return pgm_read_byte (&FONTS[character - 32][i]);
+    }
+  };
+#else
+  // text stripped (config.h), drawChar & drawString can't be used
+  struct Ssd1306Font;
+#endif
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== DISPLAY =========================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Display of Width x Height pixels on Transport, text in Font; global or
+   *          static object (zero initialized, no constructor runs)
+   */
+  template <uint8_t Width, uint8_t Height, class Transport, class Font = Ssd1306Font>
+  class Ssd1306
+  {
+    static_assert ((Width > 0) && (Width <= (END_COLUMN_ADDR + 1)), "SSD1306 width 1 ... 128");
+    static_assert ((Height == 16) || (Height == 32) || (Height == 64), "SSD1306 height 16, 32 or 64");
+
+    public:
+
+      static constexpr uint8_t Pages = Height >> 3;
+      static constexpr uint16_t Size = Width * Pages;             // framebuffer bytes
+
+      /**
+       * @brief   Init transport & display
+       *
+       * @param   void
+       *
+       * @return  uint8_t
+       */
+      uint8_t init (void)
+      {
+        Transport::init ();
+
+        return commands_P (Init, sizeof (Init));
+      }
+
+      /**
+       * @brief   Clear framebuffer
+       *
+       * @param   void
+       *
+       * @return  void
+       */
+      void clear (void)
+      {
+        memset (buffer, CLEAR_COLOR, Size);
+      }
+
+      /**
+       * @brief   Normal colors
+       *
+       * @param   void
+       *
+       * @return  uint8_t
+       */
+      uint8_t normal (void)
+      {
+        const uint8_t list[] = { SSD1306_DIS_NORMAL };
+
+        return commands (list, sizeof (list));
+      }
+
+      /**
+       * @brief   Inverse colors
+       *
+       * @param   void
+       *
+       * @return  uint8_t
+       */
+      uint8_t inverse (void)
+      {
+        const uint8_t list[] = { SSD1306_DIS_INVERSE };
+
+        return commands (list, sizeof (list));
+      }
+
+      /**
+       * @brief   Set contrast
+       *
+       * @param   uint8_t contrast -> 0 ... 255
+       *
+       * @return  uint8_t
+       */
+      uint8_t contrast (uint8_t contrast)
+      {
+        const uint8_t list[] = { SSD1306_SET_CONTRAST, contrast };
+
+        return commands (list, sizeof (list));
+      }
+
+      /**
+       * @brief   Set text position
+       *
+       * @param   uint8_t x -> 0 ... Width - 1
+       * @param   uint8_t page -> 0 ... Pages - 1
+       *
+       * @return  void
+       */
+      void setPosition (uint8_t x, uint8_t page)
+      {
+        position = x + page * Width;
+      }
+
+      /**
+       * @brief   Draw character, wraps to next page, character which doesn't fit to
+       *          the last page is not drawn
+       *
+       * @param   char character
+       *
+       * @return  uint8_t
+       */
+      uint8_t drawChar (char character)
+      {
+        uint8_t page = position / Width;
+        uint8_t x = position % Width;
+        uint8_t * column;
+        uint8_t i;
+
+        if ((x + Font::Width) > Width) {                          // doesn't fit to page
+          page++;
+          x = 0;
+        }
+        if (page >= Pages) {
+          return SSD1306_ERROR;
+        }
+        position = x + page * Width;
+        column = &buffer[position];
+        for (i = 0; i < Font::Width; i++) {
+          column[i] = Font::column (character, i);
+        }
+        position += Font::Width + 1;
+
+        return SSD1306_SUCCESS;
+      }
+
+      /**
+       * @brief   Draw string
+       *
+       * @param   const char * string
+       *
+       * @return  void
+       */
+      void drawString (const char * string)
+      {
+        while (*string) {
+          drawChar (*string++);
+        }
+      }
+
+      /**
+       * @brief   Draw pixel
+       *
+       * @param   uint8_t x -> 0 ... Width - 1
+       * @param   uint8_t y -> 0 ... Height - 1
+       *
+       * @return  uint8_t
+       */
+      uint8_t drawPixel (uint8_t x, uint8_t y)
+      {
+        if ((x >= Width) || (y >= Height)) {
+          return SSD1306_ERROR;
+        }
+        plot (x, y);
+
+        return SSD1306_SUCCESS;
+      }
+
+      /**
+       * @brief   Draw line by Bresenham algoritm, end points checked once, same order
+       *          of arguments as SSD1306_DrawLine
+       *
+       * @param   uint8_t x start position
+       * @param   uint8_t x end position
+       * @param   uint8_t y start position
+       * @param   uint8_t y end position
+       *
+       * @return  uint8_t
+       */
+      uint8_t drawLine (uint8_t x1, uint8_t x2, uint8_t y1, uint8_t y2)
+      {
+        int16_t D;                                                // determinant
+        int16_t delta_x, delta_y;                                 // deltas
+        int8_t trace_x = 1, trace_y = 1;                          // steps
+
+        if ((x1 >= Width) || (x2 >= Width) || (y1 >= Height) || (y2 >= Height)) {
+          return SSD1306_ERROR;
+        }
+        delta_x = x2 - x1;
+        delta_y = y2 - y1;
+        if (delta_x < 0) {
+          delta_x = -delta_x;
+          trace_x = -trace_x;
+        }
+        if (delta_y < 0) {
+          delta_y = -delta_y;
+          trace_y = -trace_y;
+        }
+        plot (x1, y1);
+        // Bresenham condition for m < 1 (dy < dx)
+        // -------------------------------------------------------------------------------
+        if (delta_y < delta_x) {
+          D = (delta_y << 1) - delta_x;
+          while (x1 != x2) {
+            x1 += trace_x;
+            if (D >= 0) {
+              y1 += trace_y;
+              D -= 2*delta_x;
+            }
+            D += 2*delta_y;
+            plot (x1, y1);
+          }
+        // for m > 1 (dy > dx)
+        // -------------------------------------------------------------------------------
+        } else {
+          D = delta_y - (delta_x << 1);
+          while (y1 != y2) {
+            y1 += trace_y;
+            if (D <= 0) {
+              x1 += trace_x;
+              D += 2*delta_y;
+            }
+            D -= 2*delta_x;
+            plot (x1, y1);
+          }
+        }
+
+        return SSD1306_SUCCESS;
+      }
+
+      /**
+       * @brief   Update screen - window & framebuffer
+       *
+       * @param   void
+       *
+       * @return  uint8_t
+       */
+      uint8_t update (void)
+      {
+        uint8_t status = commands_P (Window, sizeof (Window));
+
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        status = Transport::begin (SSD1306_DATA_STREAM);
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        status = Transport::write (buffer, Size);
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        Transport::end ();
+
+        return SSD1306_SUCCESS;
+      }
+
+      // @var framebuffer, horizontal addressing, page by page
+      uint8_t buffer[Size];
+
+    private:
+
+      // @const init commands for panel height, 0xA8 MUX & 0xDA COM pins from Height
+      static constexpr uint8_t Init[] PROGMEM = {
+        SSD1306_DISPLAY_OFF,
+        SSD1306_SET_MUX_RATIO, Height - 1,
+        SSD1306_MEMORY_ADDR_MODE, 0x00,                           // horizontal
+        SSD1306_SET_START_LINE,
+        SSD1306_DISPLAY_OFFSET, 0x00,
+        SSD1306_SEG_REMAP_OP,
+        SSD1306_COM_SCAN_DIR_OP,
+        SSD1306_COM_PIN_CONF, (Height == 64) ? 0x12 : 0x02,       // alternative for 64 rows
+        SSD1306_SET_CONTRAST, 0x7F,
+        SSD1306_DIS_ENT_DISP_ON,
+        SSD1306_DIS_NORMAL,
+        SSD1306_SET_OSC_FREQ, 0x80,
+        SSD1306_SET_PRECHARGE, 0xC2,
+        SSD1306_VCOM_DESELECT, 0x20,
+        SSD1306_SET_CHAR_REG, 0x14,
+        SSD1306_DEACT_SCROLL,
+        SSD1306_DISPLAY_ON
+      };
+
+      // @const window of whole framebuffer
+      static constexpr uint8_t Window[] PROGMEM = {
+        SSD1306_SET_COLUMN_ADDR, START_COLUMN_ADDR, Width - 1,
+        SSD1306_SET_PAGE_ADDR, START_PAGE_ADDR, Pages - 1
+      };
+
+      // @var text position, x + page * Width
+      uint16_t position;
+
+      /**
+       * @brief   Plot pixel, not checked
+       *
+       * @param   uint8_t x
+       * @param   uint8_t y
+       *
+       * @return  void
+       */
+      void plot (uint8_t x, uint8_t y)
+      {
+        buffer[x + (y >> 3) * Width] |= 1 << (y & 7);
+      }
+
+      /**
+       * @brief   Send commands from RAM in one command stream
+       *
+       * @param   const uint8_t * list
+       * @param   uint8_t length
+       *
+       * @return  uint8_t
+       */
+      static uint8_t commands (const uint8_t * list, uint8_t length)
+      {
+        uint8_t status = Transport::begin (SSD1306_COMMAND_STREAM);
+
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        status = Transport::write (list, length);
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        Transport::end ();
+
+        return SSD1306_SUCCESS;
+      }
+
+      /**
+       * @brief   Send commands from flash in one command stream
+       *
+       * @param   const uint8_t * list
+       * @param   uint8_t length
+       *
+       * @return  uint8_t
+       */
+      static uint8_t commands_P (const uint8_t * list, uint8_t length)
+      {
+        uint8_t status = Transport::begin (SSD1306_COMMAND_STREAM);
+
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        status = Transport::write_P (list, length);
+        if (SSD1306_SUCCESS != status) {
+          return status;
+        }
+        Transport::end ();
+
+        return SSD1306_SUCCESS;
+      }
+  };
+
+  // definitions of tables (C++11, odr-used by address)
+  // ------------------------------------------------------------------------------------
+  template <uint8_t Width, uint8_t Height, class Transport, class Font>
+  constexpr uint8_t Ssd1306<Width, Height, Transport, Font>::Init[];
+
+  template <uint8_t Width, uint8_t Height, class Transport, class Font>
+  constexpr uint8_t Ssd1306<Width, Height, Transport, Font>::Window[];
+
+#endif
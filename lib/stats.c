@@ -0,0 +1,93 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Performance counters
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        stats.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      stats.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Bus bandwidth & flush time in the field, compiled by -DSSD1306_STATS
+ */
+
+// @includes
+#include <string.h>
+#include <util/atomic.h>
+#include "stats.h"
+
+#if defined(SSD1306_STATS)
+
+// @var counters
+SSD1306_Stats _ssd1306Stats;
+
+/**
+ * @brief   Stats init - Timer1 normal mode, F_CPU / 64, counters reset
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_StatsInit (void)
+{
+  TCCR1A = 0;
+  TCCR1B = (1 << CS11) | (1 << CS10);
+  SSD1306_StatsReset ();
+}
+
+/**
+ * @brief   Stats reset
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_StatsReset (void)
+{
+  ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+    memset (&_ssd1306Stats, 0, sizeof (SSD1306_Stats));
+    _ssd1306Stats.flush_min = 0xFFFF;
+  }
+}
+
+/**
+ * @brief   Stats snapshot - copy taken with interrupts disabled, so it is consistent
+ *          even if display is driven from interrupt, average computed on copy
+ *
+ * @param   SSD1306_Stats * snapshot
+ *
+ * @return  void
+ */
+void SSD1306_StatsSnapshot (SSD1306_Stats * stats)
+{
+  ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+    memcpy (stats, &_ssd1306Stats, sizeof (SSD1306_Stats));
+  }
+  stats->flush_avg = stats->flushes ? stats->flush_sum / stats->flushes : 0;
+}
+
+/**
+ * @brief   Stats record flush duration
+ *
+ * @param   uint16_t ticks of Timer1
+ *
+ * @return  void
+ */
+void SSD1306_StatsFlush (uint16_t ticks)
+{
+  _ssd1306Stats.flushes++;
+  _ssd1306Stats.flush_sum += ticks;
+  if (ticks < _ssd1306Stats.flush_min) {
+    _ssd1306Stats.flush_min = ticks;
+  }
+  if (ticks > _ssd1306Stats.flush_max) {
+    _ssd1306Stats.flush_max = ticks;
+  }
+}
+
+#endif
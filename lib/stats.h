@@ -0,0 +1,123 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Performance counters
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        stats.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      avr/io.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Compiled in by -DSSD1306_STATS. Without it every hook below expands to
+ *              nothing and stats.c is empty, i.e. no code, no RAM, no cycles.
+ *
+ *              Flush duration is measured by Timer1 running free at F_CPU / 64
+ *              (4us at 16MHz, up to 262ms), Timer1 can't be used by application then.
+ * -------------------------------------------------------------------------------------+
+ * @usage       SSD1306_StatsInit ();
+ *              ...
+ *              SSD1306_StatsSnapshot (&stats);
+ *              SSD1306_StatsReset ();
+ */
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+  // @includes
+  #include <avr/io.h>
+
+  #if defined(SSD1306_STATS)
+
+  // Timer1 - clock select F_CPU / 64, tick in us
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_STATS_PRESCALER   64
+  #define SSD1306_STATS_TICK_US     (SSD1306_STATS_PRESCALER / (F_CPU / 1000000UL))
+
+  // Counters
+  // ------------------------------------------------------------------------------------
+  typedef struct {
+    uint16_t transactions;                // START & address (TWI) / chip select (SPI)
+    uint32_t bytes_cmd;                   // commands & control bytes
+    uint32_t bytes_data;                  // display data bytes
+    uint16_t nacks;                       // NACK / arbitration lost
+    uint16_t timeouts;                    // TWINT not set within TWI_TIMEOUT
+    uint16_t retries;                     // flush retries
+    uint16_t flushes;                     // completed SSD1306_UpdateScreen
+    uint16_t flush_min;                   // Timer1 ticks
+    uint16_t flush_max;                   // Timer1 ticks
+    uint16_t flush_avg;                   // Timer1 ticks, filled by snapshot
+    uint32_t flush_sum;                   // Timer1 ticks
+    uint32_t spins;                       // polls of TWINT flag
+    uint32_t draws;                       // draw primitive calls
+    uint32_t touched;                     // cache memory bytes written by draws
+  } SSD1306_Stats;
+
+  // @var counters
+  extern SSD1306_Stats _ssd1306Stats;
+
+  // Hooks
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_STATS_INC(FIELD)          { _ssd1306Stats.FIELD++; }
+  #define SSD1306_STATS_ADD(FIELD, N)       { _ssd1306Stats.FIELD += (N); }
+  #define SSD1306_STATS_DRAW(BYTES)         { _ssd1306Stats.draws++; _ssd1306Stats.touched += (BYTES); }
+  #define SSD1306_STATS_FLUSH_BEGIN()       uint16_t _statsFlushStart = TCNT1;
+  #define SSD1306_STATS_FLUSH_END()         SSD1306_StatsFlush (TCNT1 - _statsFlushStart);
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Stats init - Timer1 free running & counters reset
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_StatsInit (void);
+
+  /**
+   * @brief   Stats reset
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_StatsReset (void);
+
+  /**
+   * @brief   Stats snapshot - consistent copy with average
+   *
+   * @param   SSD1306_Stats *
+   *
+   * @return  void
+   */
+  void SSD1306_StatsSnapshot (SSD1306_Stats *);
+
+  /**
+   * @brief   Stats record flush duration
+   *
+   * @param   uint16_t ticks
+   *
+   * @return  void
+   */
+  void SSD1306_StatsFlush (uint16_t);
+
+  #else
+
+  #define SSD1306_STATS_INC(FIELD)
+  #define SSD1306_STATS_ADD(FIELD, N)
+  #define SSD1306_STATS_DRAW(BYTES)
+  #define SSD1306_STATS_FLUSH_BEGIN()
+  #define SSD1306_STATS_FLUSH_END()
+
+  #endif
+
+#endif
@@ -0,0 +1,185 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Bus trace recorder
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        trace.c
+ * @version     1.0.0
+ * @tested      AVR Atmega328p
+ *
+ * @depend      trace.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Record of bus traffic for tools/ssd1306_trace.py, -DSSD1306_TRACE
+ */
+
+// @includes
+#include "trace.h"
+
+#if defined(SSD1306_TRACE)
+
+// USART registers - Atmega328 USART0, Atmega8 / Atmega16 USART
+// ---------------------------------------------------------------------------------------
+#if defined(UDR0)
+  #define TRACE_UDR                     UDR0
+  #define TRACE_UCSRA                   UCSR0A
+  #define TRACE_UCSRB                   UCSR0B
+  #define TRACE_UBRRH                   UBRR0H
+  #define TRACE_UBRRL                   UBRR0L
+  #define TRACE_UDRE                    UDRE0
+  #define TRACE_TXEN                    TXEN0
+#elif defined(UDR)
+  #define TRACE_UDR                     UDR
+  #define TRACE_UCSRA                   UCSRA
+  #define TRACE_UCSRB                   UCSRB
+  #define TRACE_UBRRH                   UBRRH
+  #define TRACE_UBRRL                   UBRRL
+  #define TRACE_UDRE                    UDRE
+  #define TRACE_TXEN                    TXEN
+#endif
+
+// USART baud rate register, asynchronous normal mode
+#define TRACE_UBRR                      ((F_CPU / (16 * SSD1306_TRACE_BAUD)) - 1)
+
+// @var log
+static uint8_t traceLog[SSD1306_TRACE_SIZE];
+uint16_t _traceLength;
+uint16_t _traceLost;
+
+/**
+ * @brief   Trace init - Timer1 normal mode, F_CPU / 64, log cleared
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_TraceInit (void)
+{
+#if defined(TCCR1B)
+  TCCR1A = 0;
+  TCCR1B = (1 << CS11) | (1 << CS10);
+#endif
+  _traceLength = 0;
+  _traceLost = 0;
+}
+
+/**
+ * @brief   Trace record of two bytes, lost if log is full
+ *
+ * @param   uint8_t type
+ * @param   uint8_t value
+ *
+ * @return  void
+ */
+void SSD1306_TraceRecord (uint8_t type, uint8_t value)
+{
+  if (_traceLength > (SSD1306_TRACE_SIZE - 2)) {
+    _traceLost++;
+    return;
+  }
+  traceLog[_traceLength++] = type;
+  traceLog[_traceLength++] = value;
+}
+
+/**
+ * @brief   Trace record with timestamp of Timer1, STOP has no address
+ *
+ * @param   uint8_t type
+ * @param   uint8_t address
+ *
+ * @return  void
+ */
+void SSD1306_TraceTimed (uint8_t type, uint8_t address)
+{
+  uint16_t time = 0;
+  uint8_t length = (SSD1306_TRACE_STOP == type) ? 3 : 4;
+
+#if defined(TCCR1B)
+  time = TCNT1;
+#endif
+  if (_traceLength > (SSD1306_TRACE_SIZE - length)) {
+    _traceLost++;
+    return;
+  }
+  traceLog[_traceLength++] = type;
+  if (SSD1306_TRACE_STOP != type) {
+    traceLog[_traceLength++] = address;
+  }
+  traceLog[_traceLength++] = time & 0xFF;
+  traceLog[_traceLength++] = time >> 8;
+}
+
+/**
+ * @brief   Trace record of buffer - one data run, lost as a whole if it doesn't fit
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t flash - 1 data in PROGMEM, 0 data in RAM
+ *
+ * @return  void
+ */
+void SSD1306_TraceBuffer (const uint8_t * data, uint16_t length, uint8_t flash)
+{
+  if ((length > (SSD1306_TRACE_SIZE - 3)) || (_traceLength > (SSD1306_TRACE_SIZE - 3 - length))) {
+    _traceLost++;
+    return;
+  }
+  traceLog[_traceLength++] = SSD1306_TRACE_DATA;
+  traceLog[_traceLength++] = length & 0xFF;
+  traceLog[_traceLength++] = length >> 8;
+  while (length--) {
+    traceLog[_traceLength++] = flash ? pgm_read_byte (data++) : *data++;
+  }
+}
+
+#if defined(TRACE_UDR)
+
+/**
+ * @brief   Trace send byte by USART
+ *
+ * @param   uint8_t
+ *
+ * @return  void
+ */
+static void SSD1306_TraceSend (uint8_t data)
+{
+  while (!(TRACE_UCSRA & (1 << TRACE_UDRE)));
+  TRACE_UDR = data;
+}
+
+/**
+ * @brief   Trace dump - USART 8N1 transmitter init, header & log, log is cleared
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void SSD1306_TraceDump (void)
+{
+  uint16_t i;
+
+  TRACE_UBRRH = TRACE_UBRR >> 8;
+  TRACE_UBRRL = TRACE_UBRR & 0xFF;
+  TRACE_UCSRB = (1 << TRACE_TXEN);                                // 8N1 after reset
+  // header
+  // -------------------------------------------------------------------------------------
+  SSD1306_TraceSend ('S');
+  SSD1306_TraceSend ('S');
+  SSD1306_TraceSend ('D');
+  SSD1306_TraceSend ('T');
+  SSD1306_TraceSend (_traceLength & 0xFF);
+  SSD1306_TraceSend (_traceLength >> 8);
+  // records
+  // -------------------------------------------------------------------------------------
+  for (i = 0; i < _traceLength; i++) {
+    SSD1306_TraceSend (traceLog[i]);
+  }
+  _traceLength = 0;
+}
+
+#endif
+
+#endif
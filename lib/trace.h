@@ -0,0 +1,148 @@
+/**
+ * -------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Bus trace recorder
+ * -------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        trace.h
+ * @version     1.0.0
+ * @test        AVR Atmega328p
+ *
+ * @depend      avr/io.h
+ * -------------------------------------------------------------------------------------+
+ * @brief       Compiled in by -DSSD1306_TRACE, hooks are empty macros otherwise.
+ *              Every transport call of ssd1306.c is recorded into RAM log of
+ *              SSD1306_TRACE_SIZE bytes, recording stops when log is full. Records:
+ *
+ *                START | 0x01 | address | time LSB | time MSB |   (SPI: 0x80 | CS)
+ *                BYTE  | 0x02 | byte |                            (TWI: control & payload)
+ *                STOP  | 0x03 | time LSB | time MSB |
+ *                ERROR | 0x04 | status |
+ *                DC    | 0x05 | level |                           (SPI: 0 command, 1 data)
+ *                DATA  | 0x06 | length LSB | length MSB | bytes |  (buffer sends)
+ *
+ *              Buffers are one DATA run (3 bytes + payload), default size holds one
+ *              128x32 frame with its window (~550 bytes), 128x64 needs ~1100.
+ *              Time in Timer1 ticks at F_CPU / 64 (shared with stats.h).
+ *              SSD1306_TraceDump sends | 'S' 'S' 'D' 'T' | length LSB | length MSB |
+ *              | records | by USART 8N1 (parts without USART read log by debugger),
+ *              host analyzer: tools/ssd1306_trace.py
+ * -------------------------------------------------------------------------------------+
+ * @usage       SSD1306_TraceInit ();
+ *              ... drawing & flushes ...
+ *              SSD1306_TraceDump ();
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+  // @includes
+  #include <avr/io.h>
+  #include <avr/pgmspace.h>
+
+  #if defined(SSD1306_TRACE)
+
+  // Log size in bytes
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_TRACE_SIZE
+    #define SSD1306_TRACE_SIZE      768
+  #endif
+
+  // USART baud rate of dump
+  // ------------------------------------------------------------------------------------
+  #ifndef SSD1306_TRACE_BAUD
+    #define SSD1306_TRACE_BAUD      38400UL
+  #endif
+
+  // Records
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_TRACE_START       0x01
+  #define SSD1306_TRACE_BYTE        0x02
+  #define SSD1306_TRACE_STOP        0x03
+  #define SSD1306_TRACE_ERROR       0x04
+  #define SSD1306_TRACE_DC          0x05
+  #define SSD1306_TRACE_DATA        0x06
+
+  // Hooks
+  // ------------------------------------------------------------------------------------
+  #define SSD1306_TRACE_EVENT_START(ADDRESS)      SSD1306_TraceTimed (SSD1306_TRACE_START, (ADDRESS));
+  #define SSD1306_TRACE_EVENT_STOP()              SSD1306_TraceTimed (SSD1306_TRACE_STOP, 0);
+  #define SSD1306_TRACE_EVENT_BYTE(DATA)          SSD1306_TraceRecord (SSD1306_TRACE_BYTE, (DATA));
+  #define SSD1306_TRACE_EVENT_ERROR(STATUS)       SSD1306_TraceRecord (SSD1306_TRACE_ERROR, (STATUS));
+  #define SSD1306_TRACE_EVENT_DC(LEVEL)           SSD1306_TraceRecord (SSD1306_TRACE_DC, (LEVEL));
+  #define SSD1306_TRACE_EVENT_BUFFER(DATA, LENGTH, FLASH) SSD1306_TraceBuffer ((DATA), (LENGTH), (FLASH));
+
+  // @var bytes of log used / records lost because log was full
+  extern uint16_t _traceLength;
+  extern uint16_t _traceLost;
+
+  /**
+   * +------------------------------------------------------------------------------------+
+   * |== PUBLIC FUNCTIONS ================================================================|
+   * +------------------------------------------------------------------------------------+
+   */
+
+  /**
+   * @brief   Trace init - Timer1 free running, log cleared
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_TraceInit (void);
+
+  /**
+   * @brief   Trace record of two bytes
+   *
+   * @param   uint8_t type
+   * @param   uint8_t value
+   *
+   * @return  void
+   */
+  void SSD1306_TraceRecord (uint8_t, uint8_t);
+
+  /**
+   * @brief   Trace record with timestamp
+   *
+   * @param   uint8_t type
+   * @param   uint8_t address
+   *
+   * @return  void
+   */
+  void SSD1306_TraceTimed (uint8_t, uint8_t);
+
+  /**
+   * @brief   Trace record of buffer as one data run
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   * @param   uint8_t flash
+   *
+   * @return  void
+   */
+  void SSD1306_TraceBuffer (const uint8_t *, uint16_t, uint8_t);
+
+  /**
+   * @brief   Trace dump log by USART & clear it
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void SSD1306_TraceDump (void);
+
+  #else
+
+  #define SSD1306_TRACE_EVENT_START(ADDRESS)
+  #define SSD1306_TRACE_EVENT_STOP()
+  #define SSD1306_TRACE_EVENT_BYTE(DATA)
+  #define SSD1306_TRACE_EVENT_ERROR(STATUS)
+  #define SSD1306_TRACE_EVENT_DC(LEVEL)
+  #define SSD1306_TRACE_EVENT_BUFFER(DATA, LENGTH, FLASH)
+
+  #endif
+
+#endif
@@ -16,8 +16,12 @@
  */
  
 // include libraries
+#include <string.h>
+#include <util/atomic.h>
 #include "twi.h"
 
+#if defined(TWI_BACKEND_HW)
+
 /**
  * @desc    TWI init - initialize frequency
  *
@@ -30,20 +34,43 @@ void TWI_Init (void)
   // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
   // Calculation fclk:
   //
-  // fclk = (fcpu)/(16+2*TWBR*4^Prescaler) m16
-  // fclk = (fcpu)/(16+2*TWBR*Prescaler) m328p
+  // fclk = (fcpu)/(16+2*TWBR*4^Prescaler)
   // -------------------------------------------------------------------------------------
   // Calculation TWBR:
   // 
   // TWBR = {(fcpu/fclk) - 16 } / (2*4^Prescaler)
   // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-  // @param1 value of TWBR (m16) 
-  //  fclk = 400kHz; TWBR = 3
-  //  fclk = 100kHz; TWBR = 20
-  // @param1 value of TWBR (m328p)
-  //  fclk = 400kHz; TWBR = 2
-  // @param2 value of Prescaler = 1
-  TWI_FREQ (2, 1);
+  // TWBR and Prescaler computed at compile time from F_CPU and TWI_SCL_FREQ (twi.h)
+  //  fcpu = 16MHz, fclk = 400kHz; TWBR = 12, Prescaler = 1
+  //  fcpu = 16MHz, fclk = 100kHz; TWBR = 72, Prescaler = 1
+  TWI_FREQ (TWI_BIT_RATE, TWI_PRESCALER);
+}
+
+/**
+ * @desc    TWI set SCL frequency at runtime, same rounding as at compile time
+ *
+ * @param   uint32_t requested frequency in Hz
+ *
+ * @return  uint32_t real frequency in Hz, 0 if can't be met
+ */
+uint32_t TWI_SetFreq (uint32_t scl)
+{
+  uint32_t divider;
+  uint8_t prescaler = 0;
+
+  if ((0 == scl) || ((F_CPU / scl) < 16)) {
+    return 0;
+  }
+  divider = (F_CPU - 16 * scl + 2 * scl - 1) / (2 * scl);         // TWBR * 4^TWPS
+  while (divider > 255) {
+    if (++prescaler > 3) {
+      return 0;
+    }
+    divider = (divider + 3) >> 2;
+  }
+  TWI_FREQ ((uint8_t) divider, prescaler);
+
+  return F_CPU / (16 + 2 * divider * (1UL << (2 * prescaler)));
 }
 
 /**
@@ -55,6 +82,7 @@ void TWI_Init (void)
  */
 char TWI_MT_Start (void)
 {
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_BUS);
   // null status flag
   TWI_TWSR &= ~0xA8;
   // START
@@ -62,7 +90,9 @@ char TWI_MT_Start (void)
   // request for bus
   TWI_START();
   // wait till flag set
-  TWI_WAIT_TILL_TWINT_IS_SET();
+  if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+    return TWI_ERR_TIMEOUT;
+  }
   // test if start or repeated start acknowledged
   if ((TWI_STATUS != TWI_START_ACK) && (TWI_STATUS != TWI_REP_START_ACK)) {
     // return status
@@ -87,7 +117,9 @@ char TWI_MT_Send_SLAW (char address)
   // enable
   TWI_ENABLE();
   // wait till flag set
-  TWI_WAIT_TILL_TWINT_IS_SET();
+  if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+    return TWI_ERR_TIMEOUT;
+  }
 
   // test if SLA with WRITE acknowledged
   if (TWI_STATUS != TWI_MT_SLAW_ACK) {
@@ -113,17 +145,114 @@ char TWI_MT_Send_Data (char data)
   // enable
   TWI_ENABLE();
   // wait till flag set
-  TWI_WAIT_TILL_TWINT_IS_SET();
+  if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+    return TWI_ERR_TIMEOUT;
+  }
 
-  // test if data acknowledged
-  if (TWI_STATUS != TWI_MT_DATA_ACK) {
+  // test if data acknowledged, status read once
+  data = TWI_STATUS;
+  if (data != TWI_MT_DATA_ACK) {
     // return status
-    return TWI_STATUS;
+    return data;
   }
   // success
   return SUCCESS;
 }
 
+/**
+ * @desc    TWI Send bytes - next byte is fetched while current one is shifted out,
+ *          status is read once per byte. Inlined with constant 'flash' & 'clear'
+ *          into public variants, so the tests disappear from the loop.
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t flash - 1 data in PROGMEM, 0 data in RAM
+ * @param   uint8_t * clear - byte zeroed during transfer of every data byte, NULL none
+ * @param   uint16_t count - bytes to clear
+ *
+ * @return  char
+ */
+static inline __attribute__((always_inline)) char TWI_MT_Send_Bytes (const uint8_t * data, uint16_t length, uint8_t flash, uint8_t * clear, uint16_t count)
+{
+  uint8_t next;
+  uint8_t status;
+
+  if (0 == length) {
+    return SUCCESS;
+  }
+  next = flash ? pgm_read_byte (data++) : *data++;
+  while (1) {
+    // DATA
+    // -----------------------------------------------------------------------------------
+    TWI_TWDR = next;
+    // enable
+    TWI_ENABLE();
+    // clear during transfer
+    if (clear && count) {
+      count--;
+      *clear++ = 0;
+    }
+    // load next byte during transfer
+    if (--length) {
+      next = flash ? pgm_read_byte (data++) : *data++;
+    }
+    // wait till flag set
+    if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+      return TWI_ERR_TIMEOUT;
+    }
+    // test if data acknowledged
+    status = TWI_STATUS;
+    if (status != TWI_MT_DATA_ACK) {
+      return status;
+    }
+    if (0 == length) {
+      return SUCCESS;
+    }
+  }
+}
+
+/**
+ * @desc    TWI Send buffer from RAM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer (const uint8_t * data, uint16_t length)
+{
+  return TWI_MT_Send_Bytes (data, length, 0, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from PROGMEM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer_P (const uint8_t * data, uint16_t length)
+{
+  return TWI_MT_Send_Bytes (data, length, 1, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from RAM & clear - 'count' bytes of 'clear' are zeroed
+ *          one per data byte while it is shifted out (may be the data itself)
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t * clear
+ * @param   uint16_t count -> 0 ... length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_BufferClear (const uint8_t * data, uint16_t length, uint8_t * clear, uint16_t count)
+{
+  return TWI_MT_Send_Bytes (data, length, 0, clear, count);
+}
+
 /**
  * @desc    TWI Send address + read
  *
@@ -139,7 +268,9 @@ char TWI_MR_Send_SLAR (char address)
   // enable
   TWI_ENABLE();
   // wait till flag set
-  TWI_WAIT_TILL_TWINT_IS_SET();
+  if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+    return TWI_ERR_TIMEOUT;
+  }
 
   // test if SLA with READ acknowledged
   if (TWI_STATUS != TWI_MR_SLAR_ACK) {
@@ -150,6 +281,35 @@ char TWI_MR_Send_SLAR (char address)
   return SUCCESS;
 }
 
+/**
+ * @desc    TWI Receive data
+ *
+ * @param   char * data
+ * @param   char ack - 1 ACK (more bytes follow), 0 NACK (last byte)
+ *
+ * @return  char
+ */
+char TWI_MR_Read_Data (char * data, char ack)
+{
+  char status;
+
+  // enable, acknowledge if more bytes follow
+  // -------------------------------------------------------------------------------------
+  TWI_TWCR = (1 << TWEN) | (1 << TWINT) | (ack ? (1 << TWEA) : 0);
+  // wait till flag set
+  if (SUCCESS != TWI_WAIT_TILL_TWINT_IS_SET()) {
+    return TWI_ERR_TIMEOUT;
+  }
+  // test if data received
+  status = TWI_STATUS;
+  if (status != (ack ? TWI_MR_DATA_ACK : TWI_MR_DATA_NACK)) {
+    return status;
+  }
+  *data = TWI_TWDR;
+  // success
+  return SUCCESS;
+}
+
 /**
  * @desc    TWI stop
  *
@@ -165,4 +325,169 @@ void TWI_Stop (void)
   TWI_STOP ();
   // wait for TWINT flag is set
 //  TWI_WAIT_TILL_TWINT_IS_SET();
+  SSD1306_PROBE_END (SSD1306_PROBE_BUS);
+}
+
+/**
+ * @desc    TWI bus recovery - slave holding SDA low (e.g. after brown-out in the middle
+ *          of a byte) is clocked out by up to 9 SCL pulses, then STOP is generated.
+ *          Lines are driven open drain by bit-bang: DDR=1 -> low, DDR=0 -> released
+ *          (pulled up externally). TWI is re-initialized afterwards at the SCL rate
+ *          in use before (TWI_SetFreq / SSD1306_ProbeSpeed), not the compile time one.
+ *
+ * @param   void
+ *
+ * @return  char
+ */
+char TWI_BusRecovery (void)
+{
+  uint8_t i = 9;
+  uint8_t bitRate = TWI_TWBR;                                     // keep rate of TWI_SetFreq
+  uint8_t prescaler = TWI_TWSR & 0x03;
+
+  // disable TWI, release lines
+  // -------------------------------------------------------------------------------------
+  TWI_TWCR = 0;
+  TWI_PORT &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+  TWI_DDR &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+  _delay_us (5);
+  // clock out slave until SDA released
+  // -------------------------------------------------------------------------------------
+  while (i-- && !(TWI_PIN & (1 << TWI_SDA))) {
+    TWI_DDR |= (1 << TWI_SCL);                                    // SCL low
+    _delay_us (5);
+    TWI_DDR &= ~(1 << TWI_SCL);                                   // SCL high
+    _delay_us (5);
+  }
+  // STOP - SDA rises while SCL high
+  // -------------------------------------------------------------------------------------
+  TWI_DDR |= (1 << TWI_SCL);                                      // SCL low
+  TWI_DDR |= (1 << TWI_SDA);                                      // SDA low
+  _delay_us (5);
+  TWI_DDR &= ~(1 << TWI_SCL);                                     // SCL high
+  _delay_us (5);
+  TWI_DDR &= ~(1 << TWI_SDA);                                     // SDA high
+  _delay_us (5);
+  // TWI init - restore SCL rate, not the compile time one of TWI_Init
+  // -------------------------------------------------------------------------------------
+  TWI_FREQ (bitRate, prescaler);
+  SSD1306_PROBE_END (SSD1306_PROBE_BUS);
+  // test if bus is free
+  if (!(TWI_PIN & (1 << TWI_SDA)) || !(TWI_PIN & (1 << TWI_SCL))) {
+    return ERROR;
+  }
+  // success
+  return SUCCESS;
+}
+
+#endif
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//
+//        B U S   S C H E D U L E R   (all backends)
+//
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Clients share the bus cooperatively - long transfers (display flush) are split into
+// chunks closed by STOP and call TWI_SchedYield between them, pending transactions of
+// other clients run there by priority. Latency is measured in TWI_SchedTick ticks from
+// TWI_SchedRequest to start of the job.
+
+// @var scheduler time base
+volatile uint16_t _twiTicks;
+
+// @var registered clients, sorted by priority (highest first)
+static TWI_Client * twiClients[TWI_SCHED_CLIENTS];
+static uint8_t twiClientsCount;
+
+/**
+ * @desc    TWI scheduler register client
+ *
+ * @param   TWI_Client * client
+ * @param   TWI_Job transaction
+ * @param   void * argument of transaction
+ * @param   uint8_t priority - higher runs first
+ * @param   uint16_t deadline - ticks from request to start, 0 no deadline
+ *
+ * @return  char
+ */
+char TWI_SchedRegister (TWI_Client * client, TWI_Job job, void * arg, uint8_t priority, uint16_t deadline)
+{
+  uint8_t i;
+
+  if (twiClientsCount >= TWI_SCHED_CLIENTS) {
+    return ERROR;
+  }
+  memset (client, 0, sizeof (TWI_Client));
+  client->job = job;
+  client->arg = arg;
+  client->priority = priority;
+  client->deadline = deadline;
+  // insert sorted by priority
+  // -------------------------------------------------------------------------------------
+  i = twiClientsCount++;
+  while (i && (twiClients[i - 1]->priority < priority)) {
+    twiClients[i] = twiClients[i - 1];
+    i--;
+  }
+  twiClients[i] = client;
+
+  return SUCCESS;
 }
+
+/**
+ * @desc    TWI scheduler request transaction, callable from interrupt
+ *
+ * @param   TWI_Client * client
+ *
+ * @return  void
+ */
+void TWI_SchedRequest (TWI_Client * client)
+{
+  ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+    if (!client->pending) {
+      client->requested = _twiTicks;
+      client->pending = 1;
+    }
+  }
+}
+
+/**
+ * @desc    TWI scheduler run pending transactions by priority, every job is started
+ *          at most once per call so a client requesting from its own job can't starve
+ *          the caller
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void TWI_SchedYield (void)
+{
+  TWI_Client * client;
+  uint16_t latency;
+  uint8_t i;
+
+  for (i = 0; i < twiClientsCount; i++) {
+    client = twiClients[i];
+    if (!client->pending) {
+      continue;
+    }
+    // latency statistics
+    // -----------------------------------------------------------------------------------
+    ATOMIC_BLOCK (ATOMIC_RESTORESTATE) {
+      latency = _twiTicks - client->requested;
+      client->pending = 0;
+    }
+    client->latency = latency;
+    if (latency > client->latency_max) {
+      client->latency_max = latency;
+    }
+    if (client->deadline && (latency > client->deadline)) {
+      client->misses++;
+    }
+    client->runs++;
+    // transaction
+    // -----------------------------------------------------------------------------------
+    client->status = client->job (client->arg);
+  }
+}
+
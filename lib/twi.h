@@ -13,6 +13,10 @@
  * @depend      avr/io.h
  * --------------------------------------------------------------------------------------+
  * @usage       Basic Master Transmit Operation
+ *              Backends with the same TWI_* functions:
+ *                twi.c      - hardware TWI (parts with TWCR)
+ *                twi_usi.c  - USI in two-wire mode (ATtiny)
+ *                twi_soft.c - bit-bang on any GPIO (TWI_SOFT defined or no TWI/USI)
  */
 
 #ifndef __TWI_H__
@@ -20,6 +24,22 @@
 
   // @includes
   #include <avr/io.h>
+  #include <avr/pgmspace.h>
+  #include <util/delay.h>
+  #include "stats.h"
+  #include "probe.h"
+
+  // backend
+  // -------------------------------------------------------------------------------------
+  #if defined(TWI_SOFT)
+    #define TWI_BACKEND_SOFT
+  #elif defined(TWCR)
+    #define TWI_BACKEND_HW
+  #elif defined(USIDR)
+    #define TWI_BACKEND_USI
+  #else
+    #define TWI_BACKEND_SOFT
+  #endif
 
   // define register for TWI communication
   // -------------------------------------------------------------------------------------
@@ -33,6 +53,45 @@
 
   #endif
 
+  // define pins for TWI bus recovery & software / USI backend, TWI_PORT, TWI_DDR,
+  // TWI_PIN, TWI_SCL and TWI_SDA may be given by application for any GPIO
+  // -------------------------------------------------------------------------------------
+  #if defined(TWI_PORT)
+
+  #elif defined(__AVR_ATmega16__)
+
+    #define TWI_PORT            PORTC
+    #define TWI_DDR             DDRC
+    #define TWI_PIN             PINC
+    #define TWI_SCL             PC0
+    #define TWI_SDA             PC1
+
+  #elif defined(__AVR_ATmega8__) || defined(__AVR_ATmega328P__)
+
+    #define TWI_PORT            PORTC
+    #define TWI_DDR             DDRC
+    #define TWI_PIN             PINC
+    #define TWI_SCL             PC5
+    #define TWI_SDA             PC4
+
+  #elif defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+
+    #define TWI_PORT            PORTB
+    #define TWI_DDR             DDRB
+    #define TWI_PIN             PINB
+    #define TWI_SCL             PB2
+    #define TWI_SDA             PB0
+
+  #elif defined(__AVR_ATtiny2313__) || defined(__AVR_ATtiny2313A__) || defined(__AVR_ATtiny4313__)
+
+    #define TWI_PORT            PORTB
+    #define TWI_DDR             DDRB
+    #define TWI_PIN             PINB
+    #define TWI_SCL             PB7
+    #define TWI_SDA             PB5
+
+  #endif
+
   // Success
   // -------------------------------------------------------------------------------------
   #ifndef SUCCESS
@@ -87,16 +146,81 @@
   #define TWI_ST_DATA_NACK      0xC0  // Data byte in TWDR has been transmitted; NOT ACK has been received
   #define TWI_ST_DATA_LOST_ACK  0xC8  // Last data byte in TWDR has been transmitted (TWEA = '0'); ACK has been received
 
+  // Bus scheduler - number of clients
+  // -------------------------------------------------------------------------------------
+  #ifndef TWI_SCHED_CLIENTS
+    #define TWI_SCHED_CLIENTS   4
+  #endif
+
+  // Timeout - TWINT flag is polled at most TWI_TIMEOUT times, one poll takes ~6 cycles
+  // -------------------------------------------------------------------------------------
+  //  worst case of one wait = TWI_TIMEOUT * 6 / F_CPU, 2000 => 750us at 16MHz,
+  //  more than one byte at 100kHz incl. moderate clock stretching
+  #ifndef TWI_TIMEOUT
+    #define TWI_TIMEOUT         2000
+  #endif
+
+  // Timeout error - not a TWI status code (those are multiples of 8)
+  // -------------------------------------------------------------------------------------
+  #define TWI_ERR_TIMEOUT       0xFE
+
+  // TWI SCL frequency requested, 100kHz / 400kHz, 800kHz - 1MHz overclock accepted
+  // by many SSD1306 modules
+  // -------------------------------------------------------------------------------------
+  #ifndef TWI_SCL_FREQ
+    #define TWI_SCL_FREQ        400000UL
+  #endif
+  #ifndef F_CPU
+    #error "F_CPU not defined"
+  #endif
+
+  #if defined(TWI_BACKEND_HW)
+
   // TWI CLK frequency
   // -------------------------------------------------------------------------------------
   //  @param TWBR
-  //  @param Prescaler
+  //  @param Prescaler - TWPS bits
   //    TWPS1 TWPS0  - PRESCALER
   //      0     0    -     1
   //      0     1    -     4
   //      1     0    -    16
   //      1     1    -    64
-  #define TWI_FREQ(BIT_RATE, PRESCALER) { TWI_TWBR = BIT_RATE; TWI_TWSR |= (TWI_TWSR & 0x03) | PRESCALER; }
+  #define TWI_FREQ(BIT_RATE, PRESCALER) { TWI_TWBR = BIT_RATE; TWI_TWSR = (TWI_TWSR & ~0x03) | ((PRESCALER) & 0x03); }
+
+  // TWI bit rate & prescaler derived from F_CPU and TWI_SCL_FREQ
+  // -------------------------------------------------------------------------------------
+  //  fscl = fcpu / (16 + 2 * TWBR * 4^TWPS)  (same for Atmega16 / Atmega8 / Atmega328p)
+  //  TWBR = (fcpu / fscl - 16) / (2 * 4^TWPS), rounded up so fscl never exceeds request
+  #if (F_CPU / TWI_SCL_FREQ) < 16
+    #error "TWI_SCL_FREQ can't be met, maximum is F_CPU / 16"
+  #else
+    #define TWI_DIVIDER         ((F_CPU - 16 * TWI_SCL_FREQ + 2 * TWI_SCL_FREQ - 1) / (2 * TWI_SCL_FREQ))
+    #if TWI_DIVIDER <= 255
+      #define TWI_PRESCALER     0
+      #define TWI_BIT_RATE      TWI_DIVIDER
+    #elif ((TWI_DIVIDER + 3) / 4) <= 255
+      #define TWI_PRESCALER     1
+      #define TWI_BIT_RATE      ((TWI_DIVIDER + 3) / 4)
+    #elif ((TWI_DIVIDER + 15) / 16) <= 255
+      #define TWI_PRESCALER     2
+      #define TWI_BIT_RATE      ((TWI_DIVIDER + 15) / 16)
+    #elif ((TWI_DIVIDER + 63) / 64) <= 255
+      #define TWI_PRESCALER     3
+      #define TWI_BIT_RATE      ((TWI_DIVIDER + 63) / 64)
+    #else
+      #error "TWI_SCL_FREQ can't be met, too low for F_CPU"
+    #endif
+  #endif
+  // real frequency must not fall more than 10% below request
+  #if defined(TWI_BIT_RATE)
+    #define TWI_SCL_REAL        (F_CPU / (16 + 2 * TWI_BIT_RATE * (1UL << (2 * TWI_PRESCALER))))
+    #if (TWI_SCL_REAL * 10) < (TWI_SCL_FREQ * 9)
+      #error "TWI_SCL_FREQ can't be met within 10%"
+    #endif
+    #if (defined(__AVR_ATmega16__) || defined(__AVR_ATmega8__)) && (TWI_BIT_RATE < 10)
+      #warning "TWBR < 10, datasheet requires 10 or higher in master mode"
+    #endif
+  #endif
 
   // TWI start condition
   // -------------------------------------------------------------------------------------
@@ -118,12 +242,147 @@
   // (1 << TWINT) - TWI Interrupt Flag - must be cleared by set
   #define TWI_ENABLE()                  { TWI_TWCR = (1 << TWEN) | (1 << TWINT); }
 
-  // TWI test if TWINT Flag is set
-  #define TWI_WAIT_TILL_TWINT_IS_SET()  { while (!(TWI_TWCR & (1 << TWINT))); }
+  // TWI test if TWINT Flag is set, bounded by TWI_TIMEOUT
+  #define TWI_WAIT_TILL_TWINT_IS_SET()  TWI_Wait ()
 
   // TWI status mask
   #define TWI_STATUS                    ( TWI_TWSR & 0xF8 )
   
+  /**
+   * @desc    TWI wait till TWINT flag is set
+   *
+   * @param   void
+   *
+   * @return  char
+   */
+  static inline char TWI_Wait (void)
+  {
+    uint16_t timeout = TWI_TIMEOUT;
+
+    SSD1306_PROBE_BEGIN (SSD1306_PROBE_WAIT);
+    while (!(TWI_TWCR & (1 << TWINT))) {
+      SSD1306_STATS_INC (spins);
+      if (0 == --timeout) {
+        SSD1306_PROBE_END (SSD1306_PROBE_WAIT);
+        return TWI_ERR_TIMEOUT;
+      }
+    }
+    SSD1306_PROBE_END (SSD1306_PROBE_WAIT);
+    return SUCCESS;
+  }
+
+  #else
+
+  // Software / USI SCL period in cycles - low & high half have own overhead
+  // -------------------------------------------------------------------------------------
+  //  low half  = TWI_SOFT_HALF_LOW delay + TWI_SOFT_OVERHEAD_LOW cycles
+  //  high half = TWI_SOFT_HALF_HIGH delay + TWI_SOFT_OVERHEAD_HIGH cycles
+  //  fscl = fcpu / (sum of both); low half is half of the period but at least tLOW
+  //  1.3us, high half the rest but at least tHIGH 0.6us (fast mode). At 16MHz / 400kHz
+  //  period 40 cycles = low 21 (1.31us) + high 19 (1.19us), 50/50 would be 1.25us low.
+  //
+  //  Overheads are summed from AVR instruction timing of the code expected from -Os,
+  //  not read from a listing (check by avr-objdump -d, measure by tools/ssd1306_vcd.c
+  //  with probe.bus, override by -D):
+  //   soft  low  - sbrs + rjmp + sbi / cbi SDA + rjmp (bit 1: 6, bit 0: 5) + cbi SCL 2 = 8
+  //         high - sbi SCL 2                                                        = 2
+  //   USI   low  - sbis 1 + rjmp 2 + out USICR 1                                   = 4
+  //         high - out USICR 1                                                     = 1
+  //  ACK clock, reads and gaps between bytes differ, TWI_SCL_REAL is rate of data bits.
+  #ifndef TWI_SOFT_OVERHEAD_LOW
+    #if defined(TWI_BACKEND_USI)
+      #define TWI_SOFT_OVERHEAD_LOW   4
+    #else
+      #define TWI_SOFT_OVERHEAD_LOW   8
+    #endif
+  #endif
+  #ifndef TWI_SOFT_OVERHEAD_HIGH
+    #if defined(TWI_BACKEND_USI)
+      #define TWI_SOFT_OVERHEAD_HIGH  1
+    #else
+      #define TWI_SOFT_OVERHEAD_HIGH  2
+    #endif
+  #endif
+  #define TWI_SOFT_PERIOD       ((F_CPU + TWI_SCL_FREQ - 1) / TWI_SCL_FREQ)
+  #define TWI_SOFT_LOW_MIN      ((F_CPU * 13UL + 9999999UL) / 10000000UL)   // tLOW 1.3us
+  #define TWI_SOFT_HIGH_MIN     ((F_CPU * 6UL + 9999999UL) / 10000000UL)    // tHIGH 0.6us
+  #if (TWI_SOFT_PERIOD / 2) > TWI_SOFT_LOW_MIN
+    #define TWI_SOFT_LOW        (TWI_SOFT_PERIOD / 2)
+  #else
+    #define TWI_SOFT_LOW        TWI_SOFT_LOW_MIN
+  #endif
+  #if TWI_SOFT_PERIOD > (TWI_SOFT_LOW + TWI_SOFT_HIGH_MIN)
+    #define TWI_SOFT_HIGH       (TWI_SOFT_PERIOD - TWI_SOFT_LOW)
+  #else
+    #define TWI_SOFT_HIGH       TWI_SOFT_HIGH_MIN
+  #endif
+  #if TWI_SOFT_LOW > TWI_SOFT_OVERHEAD_LOW
+    #define TWI_SOFT_HALF_LOW   (TWI_SOFT_LOW - TWI_SOFT_OVERHEAD_LOW)
+  #else
+    #define TWI_SOFT_HALF_LOW   0
+  #endif
+  #if TWI_SOFT_HIGH > TWI_SOFT_OVERHEAD_HIGH
+    #define TWI_SOFT_HALF_HIGH  (TWI_SOFT_HIGH - TWI_SOFT_OVERHEAD_HIGH)
+  #else
+    #define TWI_SOFT_HALF_HIGH  0
+  #endif
+  #define TWI_SCL_REAL          (F_CPU / (TWI_SOFT_HALF_LOW + TWI_SOFT_OVERHEAD_LOW + TWI_SOFT_HALF_HIGH + TWI_SOFT_OVERHEAD_HIGH))
+  #if (TWI_SOFT_HALF_LOW + TWI_SOFT_OVERHEAD_LOW + TWI_SOFT_HALF_HIGH + TWI_SOFT_OVERHEAD_HIGH) > TWI_SOFT_PERIOD
+    #warning "TWI_SCL_FREQ too high for software TWI, running slower (see TWI_SCL_REAL)"
+  #endif
+
+  // Delays of low & high half period, start / stop setup & hold use the high one
+  // -------------------------------------------------------------------------------------
+  #ifndef TWI_SOFT_DELAY_LOW
+    #if TWI_SOFT_HALF_LOW > 0
+      #define TWI_SOFT_DELAY_LOW()      __builtin_avr_delay_cycles (TWI_SOFT_HALF_LOW)
+    #else
+      #define TWI_SOFT_DELAY_LOW()
+    #endif
+  #endif
+  #ifndef TWI_SOFT_DELAY_HIGH
+    #if TWI_SOFT_HALF_HIGH > 0
+      #define TWI_SOFT_DELAY_HIGH()     __builtin_avr_delay_cycles (TWI_SOFT_HALF_HIGH)
+    #else
+      #define TWI_SOFT_DELAY_HIGH()
+    #endif
+  #endif
+  #ifndef TWI_SOFT_DELAY
+    #define TWI_SOFT_DELAY()            TWI_SOFT_DELAY_HIGH()
+  #endif
+
+  #endif
+
+  // @type bus scheduler job - one complete transaction (start ... stop)
+  typedef char (*TWI_Job) (void *);
+
+  // @type bus scheduler client
+  typedef struct {
+    TWI_Job job;                          // transaction
+    void * arg;                           // argument of job
+    uint8_t priority;                     // higher runs first
+    volatile uint8_t pending;             // requested, not yet run
+    volatile uint16_t requested;          // tick of request
+    uint16_t deadline;                    // ticks from request to start
+    char status;                          // status of last run
+    uint16_t runs;                        // statistics
+    uint16_t misses;                      // runs started after deadline
+    uint16_t latency;                     // last latency in ticks
+    uint16_t latency_max;                 // worst latency in ticks
+  } TWI_Client;
+
+  // @var scheduler time base incremented by TWI_SchedTick
+  extern volatile uint16_t _twiTicks;
+
+  /**
+   * @desc    TWI scheduler tick, call from timer interrupt
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  static inline void TWI_SchedTick (void) { _twiTicks++; }
+
   /**
    * @desc    TWI init
    *
@@ -133,6 +392,15 @@
    */
   void TWI_Init (void);
 
+  /**
+   * @desc    TWI set SCL frequency at runtime
+   *
+   * @param   uint32_t
+   *
+   * @return  uint32_t
+   */
+  uint32_t TWI_SetFreq (uint32_t);
+
   /**
    * @desc    TWI MT Start
    *
@@ -160,6 +428,38 @@
    */
   char TWI_MT_Send_Data (char);
 
+  /**
+   * @desc    TWI Send buffer from RAM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  char
+   */
+  char TWI_MT_Send_Buffer (const uint8_t *, uint16_t);
+
+  /**
+   * @desc    TWI Send buffer from PROGMEM
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   *
+   * @return  char
+   */
+  char TWI_MT_Send_Buffer_P (const uint8_t *, uint16_t);
+
+  /**
+   * @desc    TWI Send buffer from RAM & clear bytes during transfer
+   *
+   * @param   const uint8_t *
+   * @param   uint16_t
+   * @param   uint8_t *
+   * @param   uint16_t
+   *
+   * @return  char
+   */
+  char TWI_MT_Send_BufferClear (const uint8_t *, uint16_t, uint8_t *, uint16_t);
+
   /**
    * @desc    TWI Send SLAR
    *
@@ -169,6 +469,16 @@
    */
   char TWI_MR_Send_SLAR (char);
 
+  /**
+   * @desc    TWI Receive data
+   *
+   * @param   char *
+   * @param   char
+   *
+   * @return  char
+   */
+  char TWI_MR_Read_Data (char *, char);
+
   /**
    * @desc    TWI stop
    *
@@ -177,5 +487,45 @@
    * @return  void
    */
   void TWI_Stop (void);
+
+  /**
+   * @desc    TWI bus recovery
+   *
+   * @param   void
+   *
+   * @return  char
+   */
+  char TWI_BusRecovery (void);
+
+  /**
+   * @desc    TWI scheduler register client
+   *
+   * @param   TWI_Client *
+   * @param   TWI_Job
+   * @param   void *
+   * @param   uint8_t priority
+   * @param   uint16_t deadline in ticks
+   *
+   * @return  char
+   */
+  char TWI_SchedRegister (TWI_Client *, TWI_Job, void *, uint8_t, uint16_t);
+
+  /**
+   * @desc    TWI scheduler request transaction of client, callable from interrupt
+   *
+   * @param   TWI_Client *
+   *
+   * @return  void
+   */
+  void TWI_SchedRequest (TWI_Client *);
+
+  /**
+   * @desc    TWI scheduler run pending transactions, bus must be free (after STOP)
+   *
+   * @param   void
+   *
+   * @return  void
+   */
+  void TWI_SchedYield (void);
   
 #endif
@@ -0,0 +1,321 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @desc        Two Wire Interface / I2C Communication - software master (bit-bang)
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @datum       18.10.2026
+ * @file        twi_soft.c
+ * @tested      AVR Atmega328
+ *
+ * @depend      twi.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Master Transmit Operation on any two GPIO pins (TWI_PORT, TWI_DDR,
+ *              TWI_PIN, TWI_SCL, TWI_SDA), compiled if TWI_SOFT is defined or the part
+ *              has neither TWI nor USI. Lines are open drain: DDR=1 drives low, DDR=0
+ *              releases the line to external pull-up. No clock stretching (SSD1306
+ *              never stretches SCL).
+ *
+ *              TWI_SOFT_NOACK - skip sampling of ACK bit, 9th clock is still generated,
+ *                               for point-to-point bus with only the display on it
+ */
+
+// include libraries
+#include "twi.h"
+
+#if defined(TWI_BACKEND_SOFT)
+
+// Lines
+// ---------------------------------------------------------------------------------------
+#define TWI_SCL_LOW()                   { TWI_DDR |= (1 << TWI_SCL); }
+#define TWI_SCL_HIGH()                  { TWI_DDR &= ~(1 << TWI_SCL); }
+#define TWI_SDA_LOW()                   { TWI_DDR |= (1 << TWI_SDA); }
+#define TWI_SDA_HIGH()                  { TWI_DDR &= ~(1 << TWI_SDA); }
+
+// One bit - data set up while SCL low, sampled by slave on rising edge
+// ---------------------------------------------------------------------------------------
+#define TWI_SOFT_BIT(DATA, BIT)         { if ((DATA) & (1 << (BIT))) TWI_SDA_HIGH() else TWI_SDA_LOW() \
+                                          TWI_SOFT_DELAY_LOW(); TWI_SCL_HIGH(); TWI_SOFT_DELAY_HIGH(); TWI_SCL_LOW(); }
+
+/**
+ * @desc    TWI send byte - unrolled, 8 data bits & ACK clock
+ *
+ * @param   uint8_t
+ *
+ * @return  char 0 ACK, 1 NACK
+ */
+static char TWI_Soft_Byte (uint8_t data)
+{
+  char nack = 0;
+
+  TWI_SOFT_BIT (data, 7);
+  TWI_SOFT_BIT (data, 6);
+  TWI_SOFT_BIT (data, 5);
+  TWI_SOFT_BIT (data, 4);
+  TWI_SOFT_BIT (data, 3);
+  TWI_SOFT_BIT (data, 2);
+  TWI_SOFT_BIT (data, 1);
+  TWI_SOFT_BIT (data, 0);
+  // ACK clock, SDA released for slave
+  // -------------------------------------------------------------------------------------
+  TWI_SDA_HIGH ();
+  TWI_SOFT_DELAY_LOW ();
+  TWI_SCL_HIGH ();
+  TWI_SOFT_DELAY_HIGH ();
+#ifndef TWI_SOFT_NOACK
+  nack = (TWI_PIN & (1 << TWI_SDA)) ? 1 : 0;
+#endif
+  TWI_SCL_LOW ();
+
+  return nack;
+}
+
+/**
+ * @desc    TWI send bytes
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t flash - 1 data in PROGMEM, 0 data in RAM
+ * @param   uint8_t * clear - byte zeroed after every data byte, NULL none
+ * @param   uint16_t count - bytes to clear
+ *
+ * @return  char
+ */
+static inline __attribute__((always_inline)) char TWI_Soft_Bytes (const uint8_t * data, uint16_t length, uint8_t flash, uint8_t * clear, uint16_t count)
+{
+  while (length--) {
+    if (TWI_Soft_Byte (flash ? pgm_read_byte (data++) : *data++)) {
+      return TWI_MT_DATA_NACK;
+    }
+    if (clear && count) {
+      count--;
+      *clear++ = 0;
+    }
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI init - release both lines
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void TWI_Init (void)
+{
+  TWI_PORT &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+  TWI_DDR &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+}
+
+/**
+ * @desc    TWI set SCL frequency - fixed at compile time by cycle counted delays
+ *
+ * @param   uint32_t requested frequency in Hz
+ *
+ * @return  uint32_t real frequency in Hz
+ */
+uint32_t TWI_SetFreq (uint32_t scl)
+{
+  (void) scl;
+
+  return TWI_SCL_REAL;
+}
+
+/**
+ * @desc    TWI MT Start / repeated start
+ *
+ * @param   void
+ *
+ * @return  char
+ */
+char TWI_MT_Start (void)
+{
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_BUS);
+  TWI_SDA_HIGH ();
+  TWI_SCL_HIGH ();
+  TWI_SOFT_DELAY ();
+  // SDA falls while SCL high
+  TWI_SDA_LOW ();
+  TWI_SOFT_DELAY ();
+  TWI_SCL_LOW ();
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send address + write
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MT_Send_SLAW (char address)
+{
+  if (TWI_Soft_Byte (address << 1)) {
+    return TWI_MT_SLAW_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send data
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Data (char data)
+{
+  if (TWI_Soft_Byte (data)) {
+    return TWI_MT_DATA_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send buffer from RAM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer (const uint8_t * data, uint16_t length)
+{
+  return TWI_Soft_Bytes (data, length, 0, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from PROGMEM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer_P (const uint8_t * data, uint16_t length)
+{
+  return TWI_Soft_Bytes (data, length, 1, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from RAM & clear
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t * clear
+ * @param   uint16_t count -> 0 ... length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_BufferClear (const uint8_t * data, uint16_t length, uint8_t * clear, uint16_t count)
+{
+  return TWI_Soft_Bytes (data, length, 0, clear, count);
+}
+
+/**
+ * @desc    TWI Send address + read
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MR_Send_SLAR (char address)
+{
+  if (TWI_Soft_Byte ((address << 1) | 0x01)) {
+    return TWI_MR_SLAR_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Receive data
+ *
+ * @param   char * data
+ * @param   char ack - 1 ACK (more bytes follow), 0 NACK (last byte)
+ *
+ * @return  char
+ */
+char TWI_MR_Read_Data (char * data, char ack)
+{
+  uint8_t byte = 0;
+  uint8_t i = 8;
+
+  TWI_SDA_HIGH ();                                                // slave drives SDA
+  while (i--) {
+    TWI_SOFT_DELAY_LOW ();
+    TWI_SCL_HIGH ();
+    TWI_SOFT_DELAY_HIGH ();
+    byte = (byte << 1) | ((TWI_PIN >> TWI_SDA) & 0x01);
+    TWI_SCL_LOW ();
+  }
+  // ACK / NACK clock
+  // -------------------------------------------------------------------------------------
+  if (ack) {
+    TWI_SDA_LOW ();
+  }
+  TWI_SOFT_DELAY_LOW ();
+  TWI_SCL_HIGH ();
+  TWI_SOFT_DELAY_HIGH ();
+  TWI_SCL_LOW ();
+  TWI_SDA_HIGH ();
+  *data = byte;
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI stop
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void TWI_Stop (void)
+{
+  TWI_SDA_LOW ();
+  TWI_SOFT_DELAY ();
+  TWI_SCL_HIGH ();
+  TWI_SOFT_DELAY ();
+  // SDA rises while SCL high
+  TWI_SDA_HIGH ();
+  TWI_SOFT_DELAY ();
+  SSD1306_PROBE_END (SSD1306_PROBE_BUS);
+}
+
+/**
+ * @desc    TWI bus recovery - up to 9 SCL pulses till slave releases SDA, then STOP
+ *
+ * @param   void
+ *
+ * @return  char
+ */
+char TWI_BusRecovery (void)
+{
+  uint8_t i = 9;
+
+  TWI_Init ();
+  while (i-- && !(TWI_PIN & (1 << TWI_SDA))) {
+    TWI_SCL_LOW ();
+    _delay_us (5);
+    TWI_SCL_HIGH ();
+    _delay_us (5);
+  }
+  TWI_SCL_LOW ();
+  TWI_Stop ();
+  // test if bus is free
+  if (!(TWI_PIN & (1 << TWI_SDA)) || !(TWI_PIN & (1 << TWI_SCL))) {
+    return ERROR;
+  }
+
+  return SUCCESS;
+}
+
+#endif
@@ -0,0 +1,323 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @desc        Two Wire Interface / I2C Communication - USI master (ATtiny)
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @datum       18.10.2026
+ * @file        twi_usi.c
+ * @tested      AVR ATtiny85
+ *
+ * @depend      twi.h
+ * --------------------------------------------------------------------------------------+
+ * @usage       Master Transmit Operation by Universal Serial Interface in two-wire
+ *              mode (according to AVR310), compiled on parts with USI and without TWI.
+ *              USI shifts SDA and detects start, SCL is strobed by software through
+ *              USITC, TWI_SOFT_NOACK skips sampling of ACK bit as in twi_soft.c.
+ */
+
+// include libraries
+#include "twi.h"
+
+#if defined(TWI_BACKEND_USI)
+
+// USI two-wire mode, software clock strobe, SCL held low after overflow
+// ---------------------------------------------------------------------------------------
+#define TWI_USI_CR                      ((1 << USIWM1) | (1 << USICS1) | (1 << USICLK))
+// clear flags, counter to 0 (16 edges = 8 bits) / 14 (2 edges = ACK bit)
+#define TWI_USI_SR_BYTE                 ((1 << USISIF) | (1 << USIOIF) | (1 << USIPF) | (1 << USIDC))
+#define TWI_USI_SR_BIT                  (TWI_USI_SR_BYTE | (0x0E << USICNT0))
+
+/**
+ * @desc    TWI shift USIDR out till counter overflows
+ *
+ * @param   uint8_t status register - number of edges
+ *
+ * @return  uint8_t USIDR
+ */
+static uint8_t TWI_Usi_Transfer (uint8_t status)
+{
+  USISR = status;
+  do {
+    TWI_SOFT_DELAY_LOW ();
+    USICR = TWI_USI_CR | (1 << USITC);                            // SCL rises
+    TWI_SOFT_DELAY_HIGH ();
+    USICR = TWI_USI_CR | (1 << USITC);                            // SCL falls
+  } while (!(USISR & (1 << USIOIF)));
+  status = USIDR;
+  USIDR = 0xFF;                                                   // release SDA
+
+  return status;
+}
+
+/**
+ * @desc    TWI send byte & ACK clock
+ *
+ * @param   uint8_t
+ *
+ * @return  char 0 ACK, 1 NACK
+ */
+static char TWI_Usi_Byte (uint8_t data)
+{
+  uint8_t ack;
+
+  TWI_PORT &= ~(1 << TWI_SCL);                                    // SCL low
+  USIDR = data;
+  TWI_Usi_Transfer (TWI_USI_SR_BYTE);
+  // ACK bit
+  // -------------------------------------------------------------------------------------
+  TWI_DDR &= ~(1 << TWI_SDA);                                     // SDA input
+  ack = TWI_Usi_Transfer (TWI_USI_SR_BIT);
+  TWI_DDR |= (1 << TWI_SDA);                                      // SDA output
+#ifdef TWI_SOFT_NOACK
+  ack = 0;
+#endif
+
+  return ack & 0x01;
+}
+
+/**
+ * @desc    TWI send bytes
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t flash - 1 data in PROGMEM, 0 data in RAM
+ * @param   uint8_t * clear - byte zeroed after every data byte, NULL none
+ * @param   uint16_t count - bytes to clear
+ *
+ * @return  char
+ */
+static inline __attribute__((always_inline)) char TWI_Usi_Bytes (const uint8_t * data, uint16_t length, uint8_t flash, uint8_t * clear, uint16_t count)
+{
+  while (length--) {
+    if (TWI_Usi_Byte (flash ? pgm_read_byte (data++) : *data++)) {
+      return TWI_MT_DATA_NACK;
+    }
+    if (clear && count) {
+      count--;
+      *clear++ = 0;
+    }
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI init - USI two-wire mode, lines released
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void TWI_Init (void)
+{
+  TWI_PORT |= (1 << TWI_SCL) | (1 << TWI_SDA);                    // USI drives via PORT
+  TWI_DDR |= (1 << TWI_SCL) | (1 << TWI_SDA);
+  USIDR = 0xFF;
+  USICR = TWI_USI_CR;
+  USISR = TWI_USI_SR_BYTE;
+}
+
+/**
+ * @desc    TWI set SCL frequency - fixed at compile time by cycle counted delays
+ *
+ * @param   uint32_t requested frequency in Hz
+ *
+ * @return  uint32_t real frequency in Hz
+ */
+uint32_t TWI_SetFreq (uint32_t scl)
+{
+  (void) scl;
+
+  return TWI_SCL_REAL;
+}
+
+/**
+ * @desc    TWI MT Start / repeated start
+ *
+ * @param   void
+ *
+ * @return  char
+ */
+char TWI_MT_Start (void)
+{
+  SSD1306_PROBE_BEGIN (SSD1306_PROBE_BUS);
+  TWI_PORT |= (1 << TWI_SDA);
+  TWI_PORT |= (1 << TWI_SCL);
+  TWI_SOFT_DELAY ();
+  // SDA falls while SCL high
+  TWI_PORT &= ~(1 << TWI_SDA);
+  TWI_SOFT_DELAY ();
+  TWI_PORT &= ~(1 << TWI_SCL);
+  TWI_PORT |= (1 << TWI_SDA);                                     // USIDR drives SDA
+  if (!(USISR & (1 << USISIF))) {
+    return TWI_FLAG_ARB_LOST;                                     // start not detected
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send address + write
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MT_Send_SLAW (char address)
+{
+  if (TWI_Usi_Byte (address << 1)) {
+    return TWI_MT_SLAW_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send data
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Data (char data)
+{
+  if (TWI_Usi_Byte (data)) {
+    return TWI_MT_DATA_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Send buffer from RAM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer (const uint8_t * data, uint16_t length)
+{
+  return TWI_Usi_Bytes (data, length, 0, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from PROGMEM
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_Buffer_P (const uint8_t * data, uint16_t length)
+{
+  return TWI_Usi_Bytes (data, length, 1, NULL, 0);
+}
+
+/**
+ * @desc    TWI Send buffer from RAM & clear
+ *
+ * @param   const uint8_t * data
+ * @param   uint16_t length
+ * @param   uint8_t * clear
+ * @param   uint16_t count -> 0 ... length
+ *
+ * @return  char
+ */
+char TWI_MT_Send_BufferClear (const uint8_t * data, uint16_t length, uint8_t * clear, uint16_t count)
+{
+  return TWI_Usi_Bytes (data, length, 0, clear, count);
+}
+
+/**
+ * @desc    TWI Send address + read
+ *
+ * @param   char
+ *
+ * @return  char
+ */
+char TWI_MR_Send_SLAR (char address)
+{
+  if (TWI_Usi_Byte ((address << 1) | 0x01)) {
+    return TWI_MR_SLAR_NACK;
+  }
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI Receive data
+ *
+ * @param   char * data
+ * @param   char ack - 1 ACK (more bytes follow), 0 NACK (last byte)
+ *
+ * @return  char
+ */
+char TWI_MR_Read_Data (char * data, char ack)
+{
+  TWI_PORT &= ~(1 << TWI_SCL);                                    // SCL low
+  TWI_DDR &= ~(1 << TWI_SDA);                                     // SDA input
+  *data = TWI_Usi_Transfer (TWI_USI_SR_BYTE);
+  TWI_DDR |= (1 << TWI_SDA);                                      // SDA output
+  // ACK / NACK bit
+  // -------------------------------------------------------------------------------------
+  USIDR = ack ? 0x00 : 0xFF;
+  TWI_Usi_Transfer (TWI_USI_SR_BIT);
+
+  return SUCCESS;
+}
+
+/**
+ * @desc    TWI stop
+ *
+ * @param   void
+ *
+ * @return  void
+ */
+void TWI_Stop (void)
+{
+  TWI_PORT &= ~(1 << TWI_SDA);
+  TWI_PORT |= (1 << TWI_SCL);
+  TWI_SOFT_DELAY ();
+  // SDA rises while SCL high
+  TWI_PORT |= (1 << TWI_SDA);
+  TWI_SOFT_DELAY ();
+  SSD1306_PROBE_END (SSD1306_PROBE_BUS);
+}
+
+/**
+ * @desc    TWI bus recovery - USI released, up to 9 SCL pulses till slave releases
+ *          SDA, then STOP & USI re-init
+ *
+ * @param   void
+ *
+ * @return  char
+ */
+char TWI_BusRecovery (void)
+{
+  uint8_t i = 9;
+
+  USICR = 0;
+  TWI_PORT &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+  TWI_DDR &= ~((1 << TWI_SCL) | (1 << TWI_SDA));
+  _delay_us (5);
+  while (i-- && !(TWI_PIN & (1 << TWI_SDA))) {
+    TWI_DDR |= (1 << TWI_SCL);                                    // SCL low
+    _delay_us (5);
+    TWI_DDR &= ~(1 << TWI_SCL);                                   // SCL high
+    _delay_us (5);
+  }
+  TWI_Init ();
+  TWI_Stop ();
+  // test if bus is free
+  if (!(TWI_PIN & (1 << TWI_SDA)) || !(TWI_PIN & (1 << TWI_SCL))) {
+    return ERROR;
+  }
+
+  return SUCCESS;
+}
+
+#endif
@@ -39,10 +39,14 @@ int main(void)
   // DRAWING
   // -------------------------------------------------------------------------------------
   SSD1306_ClearScreen ();                                         // clear screen
+#if SSD1306_USE_GRAPHICS
   SSD1306_DrawLine (0, MAX_X, 4, 4);                              // draw line
+#endif
   SSD1306_SetPosition (7, 1);                                     // set position
   SSD1306_DrawString ("SSD1306 OLED DRIVER");                     // draw string
+#if SSD1306_USE_GRAPHICS
   SSD1306_DrawLine (0, MAX_X, 18, 18);                            // draw line
+#endif
   SSD1306_SetPosition (40, 3);                                    // set position
   SSD1306_DrawString ("MATIASUS");                                // draw string
   SSD1306_SetPosition (53, 5);                                    // set position
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+SSD1306 animation encoder - converts a sequence of PBM frames into the delta
+encoded container played by SSD1306_AnimUpdate (lib/animation.h).
+
+  Header: | frames | width (columns) | pages | period (ticks) |
+  Frame:  | spans | span ... |
+  Span:   | page (+ 0x80 RLE) | column | length | payload |
+
+Stored frames: key frame, deltas 1 ... frames-1 and the loop delta back to
+frame 0. A span holds the new content of a run of changed columns in one page;
+runs closer than the cost of re-addressing on the bus are merged.
+
+Usage:
+  ssd1306_anim.py frame*.pbm -n SPINNER --period 5 -o spinner.h
+"""
+
+import argparse
+import sys
+
+from ssd1306_rle import read_pbm, to_pages, rle_encode
+
+ANIM_SPAN_RLE = 0x80
+
+# bus cost of a new span: START + SLA+W + 6 commands * 2 + data control byte
+SPAN_BUS_COST = 14
+
+
+def encode_span(page, column, data):
+    """One span, RLE payload when smaller."""
+    rle = rle_encode(data)
+    if len(rle) < len(data):
+        return bytes([page | ANIM_SPAN_RLE, column, len(data)]) + rle
+    return bytes([page, column, len(data)]) + data
+
+
+def changed_runs(prev, cur, width):
+    """Runs (start, end) of changed columns, gaps cheaper than a new span merged."""
+    runs = []
+    for x in range(width):
+        if prev is not None and prev[x] == cur[x]:
+            continue
+        if runs and x - runs[-1][1] - 1 < SPAN_BUS_COST:
+            runs[-1][1] = x
+        else:
+            runs.append([x, x])
+    return runs
+
+
+def encode_frame(prev, cur, width, pages):
+    """Frame as list of spans against previous frame (None = key frame)."""
+    spans = []
+    for page in range(pages):
+        row = cur[page * width:(page + 1) * width]
+        old = prev[page * width:(page + 1) * width] if prev is not None else None
+        for start, end in changed_runs(old, row, width):
+            spans.append(encode_span(page, start, row[start:end + 1]))
+    if len(spans) > 255:
+        raise ValueError("too many spans in frame")
+    return bytes([len(spans)]) + b"".join(spans)
+
+
+def encode_animation(frames, width, pages, period):
+    """Whole container: header, key frame, deltas and loop delta."""
+    out = bytearray([len(frames), width, pages, period])
+    out += encode_frame(None, frames[0], width, pages)
+    for i in range(1, len(frames)):
+        out += encode_frame(frames[i - 1], frames[i], width, pages)
+    out += encode_frame(frames[-1], frames[0], width, pages)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SSD1306 delta animation encoder")
+    parser.add_argument("frames", nargs="+", help="PBM frames (P1/P4) of equal size")
+    parser.add_argument("-n", "--name", default="ANIMATION", help="array name")
+    parser.add_argument("-o", "--output", help="output header (default stdout)")
+    parser.add_argument("--period", type=int, default=1, help="ticks per frame (1 ... 255)")
+    args = parser.parse_args()
+
+    size = None
+    frames = []
+    for path in args.frames:
+        width, height, rows = read_pbm(path)
+        if size and size != (width, height):
+            sys.exit("%s: frame size differs" % path)
+        size = (width, height)
+        pages, data = to_pages(width, height, rows)
+        frames.append(data)
+    if len(frames) > 255 or width > 128 or pages > 8 or not 1 <= args.period <= 255:
+        sys.exit("animation out of range")
+
+    anim = encode_animation(frames, width, pages, args.period)
+    lines = [
+        "// generated by tools/ssd1306_anim.py",
+        "// %d frames, %d x %d pages, %d bytes (raw %d bytes)"
+        % (len(frames), width, pages, len(anim), len(frames) * width * pages),
+        "const uint8_t %s[] PROGMEM = {" % args.name,
+    ]
+    for i in range(0, len(anim), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in anim[i:i + 16]) + ",")
+    lines.append("};")
+    text = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
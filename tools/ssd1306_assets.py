@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+"""
+SSD1306 asset pipeline - converts PNG / PBM / PGM images into PROGMEM bitmaps
+in the driver page layout (1 byte = 8 vertical pixels, LSB on top).
+
+For every image the smallest encoding is picked:
+  BITMAP_RAW   - plain page data
+  BITMAP_RLE   - run length encoded page data (see ssd1306_rle.py)
+  BITMAP_TILED - one index per 8x8 tile into a tile set shared by all assets
+                 of the run; identical tiles are stored only once
+
+Grayscale / color input is converted to luminance and either thresholded or
+dithered (Floyd-Steinberg). Transparent pixels are off.
+
+Usage:
+  ssd1306_assets.py icons/*.png -o icons.h --dither --report icons.txt
+
+  Exactly one .c file defines the arrays by #define SSD1306_ASSETS_DATA before
+  including the header, all other files get extern declarations.
+  ssd1306_assets.py font.png --font 5x8 -n FONTS -o font.h
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+from ssd1306_rle import BITMAP_RAW, BITMAP_RLE, rle_encode, to_pages, _pbm_tokens
+
+BITMAP_TILED = 0x02
+
+FORMAT_NAMES = {BITMAP_RAW: "BITMAP_RAW", BITMAP_RLE: "BITMAP_RLE", BITMAP_TILED: "BITMAP_TILED"}
+
+TILE_SIZE = 8
+TILES_MAX = 256
+
+
+# -------------------------------------------------------------------------------------
+# Image readers, all return (width, height, luminance rows 0 ... 255, alpha rows)
+# -------------------------------------------------------------------------------------
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Minimal PNG reader (non interlaced, all color types, depth 1 ... 16)."""
+    with open(path, "rb") as f:
+        raw = f.read()
+    if raw[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    pos = 8
+    idat = bytearray()
+    palette = []
+    trns = b""
+    while pos < len(raw):
+        length, kind = struct.unpack(">I4s", raw[pos:pos + 8])
+        chunk = raw[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNG not supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bits = channels * depth
+    stride = (width * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    data = zlib.decompress(bytes(idat))
+
+    # unfilter scanlines
+    lines = []
+    prev = bytearray(stride)
+    for y in range(height):
+        ftype = data[y * (stride + 1)]
+        line = bytearray(data[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + _paeth(a, b, c)) & 0xFF
+        lines.append(line)
+        prev = line
+
+    def samples(line):
+        if depth == 8:
+            return list(line)
+        if depth == 16:
+            return [line[i] for i in range(0, len(line), 2)]
+        per = 8 // depth
+        mask = (1 << depth) - 1
+        out = []
+        for byte in line:
+            for k in range(per):
+                out.append((byte >> (8 - depth * (k + 1))) & mask)
+        return out
+
+    scale = 255 // ((1 << depth) - 1) if depth < 8 else 1
+    lum, alpha = [], []
+    for line in lines:
+        s = samples(line)
+        lrow, arow = [], []
+        for x in range(width):
+            px = s[x * channels:(x + 1) * channels]
+            if ctype == 3:
+                r, g, b = palette[px[0]]
+                a = trns[px[0]] if px[0] < len(trns) else 255
+            elif ctype in (0, 4):
+                r = g = b = px[0] * scale
+                a = px[1] if ctype == 4 else 255
+            else:
+                r, g, b = px[0], px[1], px[2]
+                a = px[3] if ctype == 6 else 255
+            lrow.append((r * 299 + g * 587 + b * 114) // 1000)
+            arow.append(a)
+        lum.append(lrow)
+        alpha.append(arow)
+    return width, height, lum, alpha
+
+
+def read_pnm(path):
+    """PBM (P1/P4) and PGM (P2/P5) reader; PBM 1 = black is taken as pixel on."""
+    with open(path, "rb") as f:
+        raw = f.read()
+    tokens, offset = _pbm_tokens(raw)
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    lum = []
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        for y in range(height):
+            line = raw[offset + y * stride:offset + (y + 1) * stride]
+            lum.append([255 if (line[x >> 3] >> (7 - (x & 7))) & 1 else 0 for x in range(width)])
+    elif magic == b"P1":
+        bits = [c for c in raw[offset:].decode("ascii") if c in "01"]
+        for y in range(height):
+            lum.append([255 if b == "1" else 0 for b in bits[y * width:(y + 1) * width]])
+    elif magic in (b"P2", b"P5"):
+        maxval = int(tokens[3])
+        if magic == b"P5":
+            vals = list(raw[offset:offset + width * height])
+        else:
+            vals = [int(v) for v in raw[offset:].split()]
+        for y in range(height):
+            lum.append([v * 255 // maxval for v in vals[y * width:(y + 1) * width]])
+    else:
+        raise ValueError("%s: unsupported image" % path)
+    return width, height, lum, [[255] * width for _ in range(height)]
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        magic = f.read(2)
+    if magic == b"\x89P":
+        return read_png(path)
+    return read_pnm(path)
+
+
+# -------------------------------------------------------------------------------------
+# 1bpp conversion
+# -------------------------------------------------------------------------------------
+
+def to_mono(width, height, lum, alpha, threshold=128, dither=False, invert=False):
+    """Luminance to pixels (1 = on), optional Floyd-Steinberg dithering."""
+    err = [[0.0] * (width + 2) for _ in range(2)]
+    rows = []
+    for y in range(height):
+        cur, nxt = err[0], err[1]
+        row = []
+        for x in range(width):
+            value = lum[y][x] if not invert else 255 - lum[y][x]
+            if alpha[y][x] < 128:
+                row.append(0)
+                continue
+            if not dither:
+                row.append(1 if value >= threshold else 0)
+                continue
+            value += cur[x + 1]
+            on = value >= threshold
+            row.append(1 if on else 0)
+            e = value - (255 if on else 0)
+            cur[x + 2] += e * 7 / 16
+            nxt[x] += e * 3 / 16
+            nxt[x + 1] += e * 5 / 16
+            nxt[x + 2] += e * 1 / 16
+        rows.append(row)
+        err = [nxt, [0.0] * (width + 2)]
+    return rows
+
+
+def tiles_of(width, pages, data):
+    """8x8 tiles (8 columns of one page) in row major order."""
+    return [data[p * width + t * TILE_SIZE:p * width + (t + 1) * TILE_SIZE]
+            for p in range(pages) for t in range(width // TILE_SIZE)]
+
+
+# -------------------------------------------------------------------------------------
+# Encoding
+# -------------------------------------------------------------------------------------
+
+class Asset:
+    def __init__(self, name, source, width, height, pages, data):
+        self.name, self.source = name, source
+        self.width, self.height, self.pages, self.data = width, height, pages, data
+        self.sizes = {}
+        self.format = None
+        self.payload = b""
+
+
+def encode_assets(assets, force=None):
+    """Pick smallest encoding per asset; tiles are shared across assets."""
+    tileset = []
+    index = {}
+    for asset in assets:
+        header = 3
+        asset.sizes["raw"] = header + len(asset.data)
+        rle = rle_encode(asset.data)
+        asset.sizes["rle"] = header + len(rle)
+        candidates = {"raw": (BITMAP_RAW, asset.data), "rle": (BITMAP_RLE, rle)}
+
+        if asset.width % TILE_SIZE == 0:
+            tiles = tiles_of(asset.width, asset.pages, asset.data)
+            new = [t for t in dict.fromkeys(tiles) if t not in index]
+            if len(index) + len(new) <= TILES_MAX:
+                # tiles new to the set are charged to the first asset using them
+                asset.sizes["tiled"] = header + len(tiles) + TILE_SIZE * len(new)
+                candidates["tiled"] = (BITMAP_TILED, tiles)
+
+        choice = force if force in candidates else min(candidates, key=lambda k: asset.sizes[k])
+        asset.format, payload = candidates[choice]
+        if asset.format == BITMAP_TILED:
+            for tile in payload:
+                if tile not in index:
+                    index[tile] = len(tileset)
+                    tileset.append(tile)
+            payload = bytes(index[t] for t in payload)
+        asset.payload = bytes([asset.format, asset.width, asset.pages]) + payload
+    return tileset
+
+
+def c_array(name, data, comment=None, indent="  "):
+    lines = []
+    if comment:
+        lines.append("// " + comment)
+    lines.append("const uint8_t %s[] PROGMEM = {" % name)
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return lines
+
+
+def emit_header(assets, tileset, guard, tileset_name):
+    # same as fonts - defined once, every other file including the header gets extern
+    names = ([tileset_name] if tileset else []) + [a.name for a in assets]
+    lines = [
+        "// generated by tools/ssd1306_assets.py - do not edit",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "  #include <avr/pgmspace.h>",
+        "  #include \"lib/bitmap.h\"",
+        "",
+        "  // defined once by file including this with SSD1306_ASSETS_DATA",
+        "  #if defined(SSD1306_ASSETS_DATA)",
+        "",
+    ]
+    if tileset:
+        lines += ["  " + l for l in c_array(tileset_name, b"".join(tileset),
+                                             "shared tile set, %d tiles" % len(tileset))]
+        lines.append("")
+    for a in assets:
+        fmt = FORMAT_NAMES[a.format]
+        body = ["  const uint8_t %s[] PROGMEM = {" % a.name,
+                "    %s, %d, %d," % (fmt, a.width, a.pages)]
+        payload = a.payload[3:]
+        for i in range(0, len(payload), 16):
+            body.append("    " + ", ".join("0x%02x" % b for b in payload[i:i + 16]) + ",")
+        body.append("  };")
+        lines += ["  // %s: %dx%d, %s, %d bytes" % (a.source, a.width, a.height, fmt, len(a.payload))]
+        lines += body
+        lines.append("")
+    lines.append("  #else")
+    lines += ["  extern const uint8_t %s[] PROGMEM;" % n for n in names]
+    lines.append("  #endif")
+    lines.append("")
+    lines.append("#endif")
+    return "\n".join(lines) + "\n"
+
+
+def report(assets, tileset):
+    out = ["%-24s %9s %6s %6s %6s  %s" % ("asset", "size", "raw", "rle", "tiled", "chosen")]
+    total = 0
+    for a in assets:
+        total += len(a.payload)
+        out.append("%-24s %4dx%-4d %6d %6d %6s  %s" % (
+            a.name, a.width, a.height, a.sizes["raw"], a.sizes["rle"],
+            a.sizes.get("tiled", "-"), FORMAT_NAMES[a.format]))
+    raw = sum(a.sizes["raw"] for a in assets)
+    tiles = TILE_SIZE * len(tileset)
+    out.append("tile set: %d tiles, %d bytes" % (len(tileset), tiles))
+    out.append("total flash: %d bytes (raw %d bytes, saved %d bytes)"
+               % (total + tiles, raw, raw - total - tiles))
+    return "\n".join(out) + "\n"
+
+
+# -------------------------------------------------------------------------------------
+# Fonts - grid of glyphs 0x20 ... 0x7E into FONTS[][CHARS_COLS_LENGTH] (font.h), other
+# names get own width macro NAME_COLS, so several fonts can be included together
+# -------------------------------------------------------------------------------------
+
+def emit_font(rows, img_width, glyph_w, glyph_h, name):
+    per_row = img_width // glyph_w
+    cols_name = "CHARS_COLS_LENGTH" if name == "FONTS" else name + "_COLS"
+    lines = [
+        "  // generated by tools/ssd1306_assets.py",
+        "  #define %s  %d" % (cols_name, glyph_w),
+        "",
+        "  // defined once by file including this with SSD1306_FONT_DATA (lib/font.c)",
+        "  #if defined(SSD1306_FONT_DATA)",
+        "  const uint8_t %s[][%s] PROGMEM = {" % (name, cols_name),
+    ]
+    for i, code in enumerate(range(0x20, 0x7F)):
+        gx, gy = (i % per_row) * glyph_w, (i // per_row) * glyph_h
+        cols = []
+        for x in range(glyph_w):
+            byte = 0
+            for y in range(min(glyph_h, 8)):
+                if gy + y < len(rows) and rows[gy + y][gx + x]:
+                    byte |= 1 << y
+            cols.append(byte)
+        glyph = chr(code) if code != 0x5C else "backslash"
+        lines.append("    { %s }, // %02x %s" % (", ".join("0x%02x" % c for c in cols), code, glyph))
+    lines += [
+        "  };",
+        "  #else",
+        "  extern const uint8_t %s[][%s] PROGMEM;" % (name, cols_name),
+        "  #endif",
+    ]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SSD1306 PNG/PBM to PROGMEM asset pipeline")
+    parser.add_argument("images", nargs="+", help="PNG, PBM or PGM images")
+    parser.add_argument("-o", "--output", help="output header (default stdout)")
+    parser.add_argument("-n", "--name", help="array name (single image / font)")
+    parser.add_argument("--tileset", default="TILESET", help="name of shared tile set")
+    parser.add_argument("--encoding", choices=("auto", "raw", "rle", "tiled"), default="auto")
+    parser.add_argument("--dither", action="store_true", help="Floyd-Steinberg dithering")
+    parser.add_argument("--threshold", type=int, default=128, help="on threshold 0 ... 255")
+    parser.add_argument("--invert", action="store_true", help="dark pixels are on")
+    parser.add_argument("--font", metavar="WxH", help="image is a grid of glyphs 0x20 ... 0x7E")
+    parser.add_argument("--report", metavar="FILE", help="size report ('-' = stderr)")
+    args = parser.parse_args()
+
+    if args.font:
+        glyph_w, glyph_h = (int(v) for v in args.font.lower().split("x"))
+        width, height, lum, alpha = read_image(args.images[0])
+        rows = to_mono(width, height, lum, alpha, args.threshold, False, args.invert)
+        text = emit_font(rows, width, glyph_w, glyph_h, args.name or "FONTS")
+    else:
+        assets = []
+        for path in args.images:
+            width, height, lum, alpha = read_image(path)
+            if width > 128 or height > 64:
+                sys.exit("%s: %dx%d exceeds display" % (path, width, height))
+            rows = to_mono(width, height, lum, alpha, args.threshold, args.dither, args.invert)
+            pages, data = to_pages(width, height, rows)
+            stem = os.path.splitext(os.path.basename(path))[0]
+            name = args.name if args.name and len(args.images) == 1 else \
+                "".join(c if c.isalnum() else "_" for c in stem).upper()
+            assets.append(Asset(name, os.path.basename(path), width, height, pages, data))
+        force = None if args.encoding == "auto" else args.encoding
+        tileset = encode_assets(assets, force)
+        stem = os.path.splitext(os.path.basename(args.output))[0] if args.output else "assets"
+        guard = "__%s_H__" % "".join(c if c.isalnum() else "_" for c in stem).upper()
+        text = emit_header(assets, tileset, guard, args.tileset)
+        if args.report:
+            summary = report(assets, tileset)
+            if args.report == "-":
+                sys.stderr.write(summary)
+            else:
+                with open(args.report, "w") as f:
+                    f.write(summary)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""
+SSD1306 bitmap encoder - converts PBM images (or raw page data) into the
+PROGMEM bitmap format read by SSD1306_DrawBitmap_P (lib/bitmap.h).
+
+  Header: | format | width (columns) | pages | data ... |
+
+  RLE token followed by payload:
+    00cc cccc - literal, (c + 1) bytes follow
+    01cc cccc - run, next byte repeated (c + 1) times
+    10cc cccc - run of (c + 1) bytes 0x00
+    11cc cccc - run of (c + 1) bytes 0xFF
+
+Usage:
+  ssd1306_rle.py logo.pbm -n LOGO -o logo.h
+  ssd1306_rle.py screen.bin --raw-width 128 -n SCREEN
+"""
+
+import argparse
+import sys
+
+BITMAP_RAW = 0x00
+BITMAP_RLE = 0x01
+
+RLE_LITERAL = 0x00
+RLE_RUN = 0x40
+RLE_ZEROS = 0x80
+RLE_ONES = 0xC0
+RLE_MAX = 64
+
+
+def rle_encode(data):
+    """Encode page data into RLE tokens."""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX]
+            out.append(RLE_LITERAL | (len(chunk) - 1))
+            out.extend(chunk)
+            del literal[:RLE_MAX]
+
+    i = 0
+    while i < len(data):
+        value = data[i]
+        run = 1
+        while i + run < len(data) and data[i + run] == value and run < RLE_MAX:
+            run += 1
+        # 0x00 / 0xFF run costs 1 byte, other runs cost 2 bytes
+        if value in (0x00, 0xFF) and run >= 2:
+            flush_literal()
+            out.append((RLE_ZEROS if value == 0x00 else RLE_ONES) | (run - 1))
+        elif run >= 3:
+            flush_literal()
+            out.append(RLE_RUN | (run - 1))
+            out.append(value)
+        else:
+            literal.extend(data[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def rle_decode(tokens, size):
+    """Decode RLE tokens, mirror of SSD1306_Send_RLE_P; returns (data, used)."""
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        token = tokens[i]
+        i += 1
+        count = (token & 0x3F) + 1
+        kind = token & 0xC0
+        if kind == RLE_LITERAL:
+            out.extend(tokens[i:i + count])
+            i += count
+        elif kind == RLE_RUN:
+            out.extend([tokens[i]] * count)
+            i += 1
+        else:
+            out.extend([0x00 if kind == RLE_ZEROS else 0xFF] * count)
+    if len(out) != size:
+        raise ValueError("corrupted RLE stream")
+    return bytes(out), i
+
+
+def _pbm_tokens(raw):
+    """Split PBM/PGM header into tokens, skipping comments; returns (tokens, offset)."""
+    tokens = []
+    need = 3
+    i = 0
+    while len(tokens) < need:
+        while raw[i:i + 1].isspace():
+            i += 1
+        if raw[i:i + 1] == b"#":
+            while raw[i:i + 1] not in (b"\n", b""):
+                i += 1
+            continue
+        start = i
+        while raw[i:i + 1] and not raw[i:i + 1].isspace():
+            i += 1
+        tokens.append(raw[start:i])
+        if tokens[0] in (b"P2", b"P5"):
+            need = 4  # maxval
+    return tokens, i + 1
+
+
+def read_pbm(path):
+    """Read P1/P4 bitmap; returns (width, height, rows of 0/1 where 1 = pixel on)."""
+    with open(path, "rb") as f:
+        raw = f.read()
+    tokens, offset = _pbm_tokens(raw)
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    rows = []
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        for y in range(height):
+            line = raw[offset + y * stride:offset + (y + 1) * stride]
+            rows.append([(line[x >> 3] >> (7 - (x & 7))) & 1 for x in range(width)])
+    elif magic == b"P1":
+        bits = [c for c in raw[offset:].decode("ascii") if c in "01"]
+        for y in range(height):
+            rows.append([int(b) for b in bits[y * width:(y + 1) * width]])
+    else:
+        raise ValueError("%s: only P1/P4 bitmaps supported" % path)
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    """Convert rows of pixels into SSD1306 page format (LSB on top)."""
+    pages = (height + 7) // 8
+    data = bytearray(width * pages)
+    for y in range(height):
+        for x in range(width):
+            if rows[y][x]:
+                data[(y >> 3) * width + x] |= 1 << (y & 7)
+    return pages, bytes(data)
+
+
+def encode_bitmap(width, pages, data, force=None):
+    """Build bitmap with header, RLE only when it is smaller than raw."""
+    rle = rle_encode(data)
+    if force == "raw" or (force is None and len(rle) >= len(data)):
+        return bytes([BITMAP_RAW, width, pages]) + data
+    return bytes([BITMAP_RLE, width, pages]) + rle
+
+
+def to_header(name, bitmap, source):
+    """Format bitmap as PROGMEM array."""
+    fmt = {BITMAP_RAW: "BITMAP_RAW", BITMAP_RLE: "BITMAP_RLE"}.get(bitmap[0], "%d" % bitmap[0])
+    lines = [
+        "// generated by tools/ssd1306_rle.py from %s" % source,
+        "// %d x %d pages, %s, %d bytes" % (bitmap[1], bitmap[2], fmt, len(bitmap)),
+        "const uint8_t %s[] PROGMEM = {" % name,
+        "  %s, %d, %d," % (fmt, bitmap[1], bitmap[2]),
+    ]
+    body = bitmap[3:]
+    for i in range(0, len(body), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in body[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SSD1306 PROGMEM bitmap encoder")
+    parser.add_argument("input", help="PBM image (P1/P4) or raw page data with --raw-width")
+    parser.add_argument("-n", "--name", default="BITMAP", help="array name")
+    parser.add_argument("-o", "--output", help="output header (default stdout)")
+    parser.add_argument("--raw-width", type=int, help="input is raw page data of given width")
+    parser.add_argument("--format", choices=("raw", "rle"), help="force format")
+    args = parser.parse_args()
+
+    if args.raw_width:
+        with open(args.input, "rb") as f:
+            data = f.read()
+        width = args.raw_width
+        pages = len(data) // width
+        data = data[:width * pages]
+    else:
+        width, height, rows = read_pbm(args.input)
+        pages, data = to_pages(width, height, rows)
+    if width > 128 or pages > 8:
+        sys.exit("bitmap %dx%d pages exceeds 128x8 pages" % (width, pages))
+
+    bitmap = encode_bitmap(width, pages, data, args.format)
+    if bitmap[0] == BITMAP_RLE:
+        assert rle_decode(bitmap[3:], len(data))[0] == data
+    text = to_header(args.name, bitmap, args.input)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    sys.stderr.write("%s: raw %d bytes -> %d bytes\n" % (args.name, len(data) + 3, len(bitmap)))
+
+
+if __name__ == "__main__":
+    main()
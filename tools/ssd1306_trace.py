@@ -0,0 +1,353 @@
+#!/usr/bin/env python3
+"""
+SSD1306 bus trace analyzer - replays the log recorded by lib/trace.c
+(-DSSD1306_TRACE) through a model of the SSD1306 command decoder and GDDRAM
+and reports how much of the bus traffic actually changed the panel.
+
+  START | 0x01 | address | time LSB | time MSB |   (SPI: 0x80 | CS)
+  BYTE  | 0x02 | byte |
+  STOP  | 0x03 | time LSB | time MSB |
+  ERROR | 0x04 | status |
+  DC    | 0x05 | level |                           (SPI only)
+  DATA  | 0x06 | length LSB | length MSB | bytes |  (buffer sends)
+
+Input is a serial capture of SSD1306_TraceDump (one or more blocks starting
+with 'SSDT' + 16-bit length) or a bare log without header.
+
+Transactions separated by less than --gap ticks of idle bus form one frame.
+Per frame it reports:
+  actual     - bus bytes sent (address, control bytes, commands, data)
+  unchanged  - data bytes that wrote the value GDDRAM already held
+  redundant  - command bytes that didn't change controller state
+  split      - transactions that followed STOP to the same address and could
+               have been merged into the previous one
+  ideal      - bytes needed for the changed GDDRAM cells only: runs of changed
+               columns per page (gaps cheaper than re-addressing merged) with
+               window set, plus non-redundant non-addressing commands
+
+Usage:
+  ssd1306_trace.py capture.bin
+  ssd1306_trace.py capture.bin --pages 8 --verbose
+"""
+
+import argparse
+import sys
+
+TRACE_START = 0x01
+TRACE_BYTE = 0x02
+TRACE_STOP = 0x03
+TRACE_ERROR = 0x04
+TRACE_DC = 0x05
+TRACE_DATA = 0x06
+
+SSD1306_SPI = 0x80
+
+# bus cost of one window: TWI SLA+W + 6 commands * 2 + data control byte,
+# SPI 6 commands
+SPAN_COST_TWI = 14
+SPAN_COST_SPI = 6
+
+# number of arguments of commands with arguments
+COMMAND_ARGS = {
+    0x20: 1, 0x21: 2, 0x22: 2, 0x26: 6, 0x27: 6, 0x29: 5, 0x2A: 5, 0x81: 1,
+    0x8D: 1, 0xA3: 2, 0xA8: 1, 0xD3: 1, 0xD5: 1, 0xD9: 1, 0xDA: 1, 0xDB: 1,
+}
+
+# commands only moving the GDDRAM pointer, covered by ideal window cost
+ADDRESSING = {0x20, 0x21, 0x22}
+
+
+def state_key(command):
+    """Controller setting written by command, None for commands without state."""
+    if command <= 0x0F:
+        return "column_low"
+    if command <= 0x1F:
+        return "column_high"
+    if 0x40 <= command <= 0x7F:
+        return "start_line"
+    if 0xB0 <= command <= 0xB7:
+        return "page"
+    pairs = {0xA0: "seg_remap", 0xA1: "seg_remap", 0xA4: "entire_on", 0xA5: "entire_on",
+             0xA6: "inverse", 0xA7: "inverse", 0xAE: "display", 0xAF: "display",
+             0xC0: "com_scan", 0xC8: "com_scan", 0x2E: "scroll", 0x2F: "scroll"}
+    if command in pairs:
+        return pairs[command]
+    if command in COMMAND_ARGS and command not in (0x21, 0x22):
+        return "cmd_%02x" % command
+    return None
+
+
+def read_log(raw):
+    """Concatenated records of all dump blocks, whole input if there is no header."""
+    if b"SSDT" not in raw:
+        return raw
+    log = bytearray()
+    pos = raw.find(b"SSDT")
+    while pos >= 0 and pos + 6 <= len(raw):
+        length = raw[pos + 4] | (raw[pos + 5] << 8)
+        log += raw[pos + 6:pos + 6 + length]
+        pos = raw.find(b"SSDT", pos + 6 + length)
+    return bytes(log)
+
+
+def parse(log):
+    """Records as tuples (type, value, time), data runs as BYTE records."""
+    events = []
+    i = 0
+    while i < len(log):
+        kind = log[i]
+        if kind == TRACE_START and i + 4 <= len(log):
+            events.append((kind, log[i + 1], log[i + 2] | (log[i + 3] << 8)))
+            i += 4
+        elif kind == TRACE_STOP and i + 3 <= len(log):
+            events.append((kind, None, log[i + 1] | (log[i + 2] << 8)))
+            i += 3
+        elif kind in (TRACE_BYTE, TRACE_ERROR, TRACE_DC) and i + 2 <= len(log):
+            events.append((kind, log[i + 1], None))
+            i += 2
+        elif kind == TRACE_DATA and i + 3 <= len(log):
+            length = log[i + 1] | (log[i + 2] << 8)
+            if i + 3 + length > len(log):
+                sys.exit("corrupted trace at offset %d" % i)
+            events.extend((TRACE_BYTE, value, None) for value in log[i + 3:i + 3 + length])
+            i += 3 + length
+        else:
+            sys.exit("corrupted trace at offset %d" % i)
+    return events
+
+
+class Panel:
+    """SSD1306 command decoder & GDDRAM, state kept across transactions."""
+
+    def __init__(self, pages):
+        self.pages = pages
+        self.ram = [[0] * 128 for _ in range(pages)]
+        self.mode = 2                             # page addressing after reset
+        self.col, self.col_start, self.col_end = 0, 0, 127
+        self.page, self.page_start, self.page_end = 0, 0, pages - 1
+        self.settings = {}
+        self.pending = None                       # [command, args], survives STOP
+        self.redundant = 0
+        self.effective = 0                        # non-addressing command bytes
+
+    def snapshot(self):
+        return [row[:] for row in self.ram]
+
+    def data(self, value):
+        """Write data byte, True if cell changed."""
+        page = self.page % self.pages
+        changed = self.ram[page][self.col] != value
+        self.ram[page][self.col] = value
+        if self.mode == 0:
+            self.col += 1
+            if self.col > self.col_end:
+                self.col = self.col_start
+                self.page = self.page_start if self.page >= self.page_end else self.page + 1
+        elif self.mode == 1:
+            self.page += 1
+            if self.page > self.page_end:
+                self.page = self.page_start
+                self.col = self.col_start if self.col >= self.col_end else self.col + 1
+        else:
+            self.col = self.col_start if self.col >= 127 else self.col + 1
+        return changed
+
+    def command(self, value):
+        """Command or argument byte, counts redundant ones."""
+        if self.pending is None:
+            args = COMMAND_ARGS.get(value, 0)
+            if value == 0xE3:                     # NOP completes interrupted command
+                self.redundant += 1
+                return
+            if args:
+                self.pending = [value, []]
+                return
+            self.execute(value, [])
+            return
+        self.pending[1].append(value)
+        if len(self.pending[1]) == COMMAND_ARGS[self.pending[0]]:
+            command, args = self.pending
+            self.pending = None
+            self.execute(command, args)
+
+    def execute(self, command, args):
+        size = 1 + len(args)
+        if command == 0x21:
+            start, end = args[0] & 0x7F, args[1] & 0x7F
+            same = (start, end, self.col) == (self.col_start, self.col_end, start)
+            self.col_start, self.col_end, self.col = start, end, start
+        elif command == 0x22:
+            start, end = args[0] & 0x07, args[1] & 0x07
+            same = (start, end, self.page) == (self.page_start, self.page_end, start)
+            self.page_start, self.page_end, self.page = start, end, start
+        elif command == 0x20:
+            same = self.mode == (args[0] & 0x03)
+            self.mode = args[0] & 0x03
+        elif command <= 0x0F:
+            same = (self.col & 0x0F) == command
+            self.col = (self.col & 0xF0) | command
+        elif command <= 0x1F:
+            same = (self.col >> 4) == (command & 0x07)
+            self.col = ((command & 0x07) << 4) | (self.col & 0x0F)
+        elif 0xB0 <= command <= 0xB7:
+            same = self.page == (command & 0x07)
+            self.page = command & 0x07
+        else:
+            key = state_key(command)
+            value = (command, tuple(args))
+            same = key is not None and self.settings.get(key) == value
+            if key is not None:
+                self.settings[key] = value
+            if not same:
+                self.effective += size
+        if same:
+            self.redundant += size
+
+
+def ideal_bytes(before, after, span_cost):
+    """Bytes to write only changed cells, runs merged like tools/ssd1306_anim.py."""
+    total = 0
+    for old, new in zip(before, after):
+        runs = []
+        for x in range(128):
+            if old[x] == new[x]:
+                continue
+            if runs and x - runs[-1][1] - 1 < span_cost:
+                runs[-1][1] = x
+            else:
+                runs.append([x, x])
+        total += sum(span_cost + end - start + 1 for start, end in runs)
+    return total
+
+
+class Frame:
+    def __init__(self, ram):
+        self.before = ram
+        self.actual = 0
+        self.data = 0
+        self.unchanged = 0
+        self.redundant = 0
+        self.effective = 0
+        self.transactions = 0
+        self.split = 0
+        self.errors = 0
+        self.spi = False
+        self.start = None
+        self.end = None
+        self.notes = []
+
+
+def analyze(events, pages, gap):
+    """Replay events, list of frames."""
+    panel = Panel(pages)
+    frames = []
+    frame = None
+    address = None
+    last_stop = None                              # (time, address) of previous STOP
+    spi_dc = 0
+    ctrl = None                                   # TWI: None expects control byte
+    stream = False
+
+    def close():
+        frame.redundant = panel.redundant - frame.redundant
+        frame.effective = panel.effective - frame.effective
+        frame.after = panel.snapshot()
+        frames.append(frame)
+
+    for kind, value, time in events:
+        if kind == TRACE_START:
+            repeated = address is not None
+            if not repeated:
+                if frame is None or (last_stop and ((time - last_stop[0]) & 0xFFFF) > gap):
+                    if frame is not None:
+                        close()
+                    frame = Frame(panel.snapshot())
+                    frame.redundant = panel.redundant
+                    frame.effective = panel.effective
+                    frame.start = time
+                    last_stop = None
+                frame.transactions += 1
+                if last_stop and last_stop[1] == value:
+                    frame.split += 1
+                    frame.notes.append("split transaction at tick %d" % time)
+            address = value
+            frame.spi = bool(value & SSD1306_SPI)
+            if not frame.spi:
+                frame.actual += 1                 # SLA+W
+            ctrl, stream = None, False
+        elif kind == TRACE_DC:
+            spi_dc = value
+        elif kind == TRACE_BYTE:
+            if frame is None or address is None:
+                continue
+            frame.actual += 1
+            if frame.spi:
+                is_data = spi_dc == 1
+            elif ctrl is None:
+                ctrl = value & 0x40               # D/C#
+                stream = not (value & 0x80)       # Co = 0, rest of transaction
+                continue
+            else:
+                is_data = bool(ctrl)
+                if not stream:
+                    ctrl = None
+            if is_data:
+                frame.data += 1
+                if not panel.data(value):
+                    frame.unchanged += 1
+            else:
+                panel.command(value)
+        elif kind in (TRACE_STOP, TRACE_ERROR):
+            if kind == TRACE_ERROR:
+                if frame is not None:
+                    frame.errors += 1
+                    frame.notes.append("error 0x%02x" % value)
+                time = frame.end if frame else 0
+            if frame is not None and address is not None:
+                last_stop = (time if time is not None else 0, address)
+                frame.end = time
+            address = None
+    if frame is not None:
+        close()
+    for frame in frames:
+        span_cost = SPAN_COST_SPI if frame.spi else SPAN_COST_TWI
+        frame.ideal = ideal_bytes(frame.before, frame.after, span_cost)
+        if frame.effective:
+            frame.ideal += frame.effective + (0 if frame.spi else 2)
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SSD1306 bus trace analyzer")
+    parser.add_argument("trace", help="capture of SSD1306_TraceDump or bare log")
+    parser.add_argument("--pages", type=int, default=4, help="display pages (4 or 8)")
+    parser.add_argument("--gap", type=int, default=250, help="idle ticks between frames")
+    parser.add_argument("--tick-us", type=float, default=4.0, help="us per tick (F_CPU / 64)")
+    parser.add_argument("-v", "--verbose", action="store_true", help="list findings")
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        events = parse(read_log(f.read()))
+    frames = analyze(events, args.pages, args.gap)
+    if not frames:
+        sys.exit("no transactions in trace")
+
+    print("frame  trans  split  actual  ideal  data  unchanged  redundant  errors  time[us]")
+    totals = [0] * 8
+    for i, frame in enumerate(frames):
+        duration = ((frame.end or frame.start) - frame.start) & 0xFFFF
+        row = [frame.transactions, frame.split, frame.actual, frame.ideal, frame.data,
+               frame.unchanged, frame.redundant, frame.errors]
+        totals = [a + b for a, b in zip(totals, row)]
+        print("%5d  %5d  %5d  %6d  %5d  %4d  %9d  %9d  %6d  %8.0f"
+              % tuple([i] + row + [duration * args.tick_us]))
+        if args.verbose:
+            for note in frame.notes:
+                print("       - " + note)
+    print("total  %5d  %5d  %6d  %5d  %4d  %9d  %9d  %6d" % tuple(totals))
+    if totals[2]:
+        print("efficiency %.1f %% (ideal / actual bytes)" % (100.0 * totals[3] / totals[2]))
+
+
+if __name__ == "__main__":
+    main()
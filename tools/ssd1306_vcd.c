@@ -0,0 +1,336 @@
+/**
+ * --------------------------------------------------------------------------------------+
+ * @brief       SSD1306 Timeline of display stack in simavr
+ * --------------------------------------------------------------------------------------+
+ *              Copyright (C) 2020 Marian Hrinko.
+ *              Written by Marian Hrinko (mato.hrinko@gmail.com)
+ *
+ * @author      Marian Hrinko
+ * @date        18.10.2026
+ * @file        ssd1306_vcd.c
+ * @version     1.0.0
+ *
+ * @depend      simavr (>= 1.6), libelf
+ * --------------------------------------------------------------------------------------+
+ * @brief       Host program (not part of firmware). Runs firmware built with
+ *              -DSSD1306_PROBE in simavr and writes VCD for GTKWave with:
+ *
+ *                probe.init ... probe.app1 - bits of SSD1306_PROBE_REG (lib/probe.h),
+ *                                             GPIOR0 by default, other register by
+ *                                             its data space address (-r), e.g.
+ *                                             PORTD 0x32 on Atmega8 / 16 / 328
+ *                i2c.bus                    - 1 from START to STOP
+ *                i2c.data                   - last byte written to display
+ *                spi.cs, spi.dc             - chip select & D/C pins of SPI panel
+ *                spi.data                   - last byte shifted out by SPI
+ *
+ *              and prints cycles every probe was high in total (probe.app0 / app1 time
+ *              application code, 'make bench') and bytes received by both panels.
+ *
+ *              A slave at SSD1306 address acknowledges every byte, so the library
+ *              runs the same paths as with real panel. Hardware TWI of simavr works
+ *              on byte level, SCL / SDA edges are not modelled. SPI panel counts
+ *              command (D/C low) and data (D/C high) bytes shifted out while its CS
+ *              is low - SPI flushes and SSD1306_StreamScreen are checked by data
+ *              bytes per transaction (CACHE_SIZE_MEM per frame). CS and D/C are pins
+ *              of port -p (default B), -c and -d (default 2 and 1, SPI_SS and SPI_DC
+ *              of Atmega8 / 328).
+ *
+ *              gcc -O2 tools/ssd1306_vcd.c -o tools/ssd1306_vcd -lsimavr -lelf
+ * --------------------------------------------------------------------------------------+
+ * @usage       make vcd
+ *              tools/ssd1306_vcd [-m atmega328p] [-f 16000000] [-t ms] [-r 0x3E]
+ *                                [-p B] [-c 2] [-d 1] main.elf out.vcd
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/sim_vcd_file.h>
+#include <simavr/avr_twi.h>
+#include <simavr/avr_spi.h>
+#include <simavr/avr_ioport.h>
+
+// GPIOR0 in data space of Atmega48 / 88 / 168 / 328 (SPH on Atmega8 / 16)
+#define PROBE_GPIOR0                    0x3E
+// SSD1306_ADDR << 1
+#define SLAVE_ADDR                      0x78
+// VCD flush period in us
+#define VCD_PERIOD                      100
+
+// slave irqs
+// ---------------------------------------------------------------------------------------
+enum {
+  SLAVE_TWI_INPUT = TWI_IRQ_INPUT,
+  SLAVE_TWI_OUTPUT = TWI_IRQ_OUTPUT,
+  SLAVE_BUS,
+  SLAVE_DATA,
+  SLAVE_COUNT
+};
+
+static const char * slaveNames[SLAVE_COUNT] = {
+  [SLAVE_TWI_INPUT] = "8>ssd1306.out",
+  [SLAVE_TWI_OUTPUT] = "32<ssd1306.in",
+  [SLAVE_BUS] = "1>i2c.bus",
+  [SLAVE_DATA] = "8>i2c.data",
+};
+
+static const char * probeNames[8] = {
+  "probe.init", "probe.update", "probe.string", "probe.line",
+  "probe.bus", "probe.wait", "probe.app0", "probe.app1"
+};
+
+// @var probes - cycles high in total, cycle of last rising edge, state
+static avr_t * probeAvr;
+static avr_cycle_count_t probeCycles[8];
+static avr_cycle_count_t probeSince[8];
+static uint8_t probeState;
+
+// @var slave
+static avr_irq_t * slaveIrq;
+static uint8_t slaveSelected;
+static unsigned long slaveBytes;
+
+// @var SPI panel - pin levels, transactions, command & data bytes, data of last one
+enum { SPI_PIN_CS, SPI_PIN_DC };
+static uint8_t spiSelected;
+static uint8_t spiDc;
+static unsigned long spiTransactions;
+static unsigned long spiCommands;
+static unsigned long spiData;
+static unsigned long spiLast;
+
+/**
+ * @brief   Slave - acknowledges address & every written byte
+ *
+ * @param   struct avr_irq_t * irq
+ * @param   uint32_t value - avr_twi_msg_irq_t
+ * @param   void * param
+ *
+ * @return  void
+ */
+static void slave_hook (struct avr_irq_t * irq, uint32_t value, void * param)
+{
+  avr_twi_msg_irq_t msg;
+
+  (void) irq;
+  (void) param;
+  msg.u.v = value;
+  if (msg.u.twi.msg & TWI_COND_STOP) {
+    slaveSelected = 0;
+    avr_raise_irq (slaveIrq + SLAVE_BUS, 0);
+  }
+  if (msg.u.twi.msg & TWI_COND_START) {
+    slaveSelected = 0;
+    avr_raise_irq (slaveIrq + SLAVE_BUS, 1);
+    if ((msg.u.twi.addr & 0xFE) == SLAVE_ADDR) {
+      slaveSelected = 1;
+      avr_raise_irq (slaveIrq + SLAVE_TWI_INPUT, avr_twi_irq_msg (TWI_COND_ACK, msg.u.twi.addr, 1));
+    }
+  }
+  if (slaveSelected && (msg.u.twi.msg & TWI_COND_WRITE)) {
+    slaveBytes++;
+    avr_raise_irq (slaveIrq + SLAVE_DATA, msg.u.twi.data);
+    avr_raise_irq (slaveIrq + SLAVE_TWI_INPUT, avr_twi_irq_msg (TWI_COND_ACK, msg.u.twi.addr, 1));
+  }
+}
+
+/**
+ * @brief   SPI panel - byte shifted out by master, counted only while CS is low
+ *
+ * @param   struct avr_irq_t * irq
+ * @param   uint32_t value - byte
+ * @param   void * param
+ *
+ * @return  void
+ */
+static void spi_hook (struct avr_irq_t * irq, uint32_t value, void * param)
+{
+  (void) irq;
+  (void) value;
+  (void) param;
+  if (!spiSelected) {
+    return;
+  }
+  if (spiDc) {
+    spiData++;
+    spiLast++;
+  } else {
+    spiCommands++;
+  }
+}
+
+/**
+ * @brief   SPI panel - CS & D/C pins, falling CS starts transaction
+ *
+ * @param   struct avr_irq_t * irq
+ * @param   uint32_t value - pin level
+ * @param   void * param - SPI_PIN_CS / SPI_PIN_DC
+ *
+ * @return  void
+ */
+static void spi_pin_hook (struct avr_irq_t * irq, uint32_t value, void * param)
+{
+  (void) irq;
+  if (SPI_PIN_DC == (int) (intptr_t) param) {
+    spiDc = value & 1;
+    return;
+  }
+  if (!(value & 1) && !spiSelected) {
+    spiTransactions++;
+    spiLast = 0;
+  }
+  spiSelected = !(value & 1);
+}
+
+/**
+ * @brief   Probe - sums cycles between edges of probe register bit, hook is called by
+ *          every write of the register
+ *
+ * @param   struct avr_irq_t * irq
+ * @param   uint32_t value - bit
+ * @param   void * param - bit number
+ *
+ * @return  void
+ */
+static void probe_hook (struct avr_irq_t * irq, uint32_t value, void * param)
+{
+  int bit = (int) (intptr_t) param;
+
+  (void) irq;
+  if (value && !(probeState & (1 << bit))) {
+    probeState |= (1 << bit);
+    probeSince[bit] = probeAvr->cycle;
+  } else if (!value && (probeState & (1 << bit))) {
+    probeState &= ~(1 << bit);
+    probeCycles[bit] += probeAvr->cycle - probeSince[bit];
+  }
+}
+
+/**
+ * @brief   Main
+ *
+ * @param   int argc
+ * @param   char ** argv
+ *
+ * @return  int
+ */
+int main (int argc, char ** argv)
+{
+  const char * mcu = "atmega328p";
+  unsigned long frequency = 16000000UL;
+  unsigned long ms = 5000;
+  unsigned long reg = 0;
+  char port = 'B';
+  int cs = 2;
+  int dc = 1;
+  elf_firmware_t firmware;
+  avr_vcd_t vcd;
+  avr_t * avr;
+  avr_cycle_count_t limit;
+  int state;
+  int opt;
+  int i;
+
+  while ((opt = getopt (argc, argv, "m:f:t:r:p:c:d:")) != -1) {
+    switch (opt) {
+      case 'm': mcu = optarg; break;
+      case 'f': frequency = strtoul (optarg, NULL, 0); break;
+      case 't': ms = strtoul (optarg, NULL, 0); break;
+      case 'r': reg = strtoul (optarg, NULL, 0); break;
+      case 'p': port = optarg[0]; break;
+      case 'c': cs = atoi (optarg); break;
+      case 'd': dc = atoi (optarg); break;
+      default:
+        fprintf (stderr, "usage: %s [-m mcu] [-f hz] [-t ms] [-r addr] [-p port] [-c cs] [-d dc] firmware.elf out.vcd\n", argv[0]);
+        return 1;
+    }
+  }
+  if (argc - optind != 2) {
+    fprintf (stderr, "usage: %s [-m mcu] [-f hz] [-t ms] [-r addr] [-p port] [-c cs] [-d dc] firmware.elf out.vcd\n", argv[0]);
+    return 1;
+  }
+  // firmware
+  // -------------------------------------------------------------------------------------
+  memset (&firmware, 0, sizeof (firmware));
+  if (elf_read_firmware (argv[optind], &firmware)) {
+    fprintf (stderr, "%s: can't read firmware\n", argv[optind]);
+    return 1;
+  }
+  if (!firmware.mmcu[0]) {
+    strncpy (firmware.mmcu, mcu, sizeof (firmware.mmcu) - 1);
+  }
+  if (!firmware.frequency) {
+    firmware.frequency = frequency;
+  }
+  avr = avr_make_mcu_by_name (firmware.mmcu);
+  if (!avr) {
+    fprintf (stderr, "%s: unknown mcu\n", firmware.mmcu);
+    return 1;
+  }
+  // probe register - parts without GPIOR0 have SPH at its address
+  // -------------------------------------------------------------------------------------
+  if (!reg) {
+    if (!strcmp (firmware.mmcu, "atmega8") || !strcmp (firmware.mmcu, "atmega16")) {
+      fprintf (stderr, "%s: no GPIOR0, give address of SSD1306_PROBE_REG by -r\n", firmware.mmcu);
+      return 1;
+    }
+    reg = PROBE_GPIOR0;
+  }
+  avr_init (avr);
+  avr_load_firmware (avr, &firmware);
+  // slave on TWI
+  // -------------------------------------------------------------------------------------
+  slaveIrq = avr_alloc_irq (&avr->irq_pool, 0, SLAVE_COUNT, slaveNames);
+  avr_irq_register_notify (slaveIrq + SLAVE_TWI_OUTPUT, slave_hook, NULL);
+  avr_connect_irq (slaveIrq + SLAVE_TWI_INPUT, avr_io_getirq (avr, AVR_IOCTL_TWI_GETIRQ (0), TWI_IRQ_INPUT));
+  avr_connect_irq (avr_io_getirq (avr, AVR_IOCTL_TWI_GETIRQ (0), TWI_IRQ_OUTPUT), slaveIrq + SLAVE_TWI_OUTPUT);
+  // SPI panel - output of SPI, CS & D/C pins
+  // -------------------------------------------------------------------------------------
+  spiSelected = 0;
+  avr_irq_register_notify (avr_io_getirq (avr, AVR_IOCTL_SPI_GETIRQ (0), SPI_IRQ_OUTPUT), spi_hook, NULL);
+  avr_irq_register_notify (avr_io_getirq (avr, AVR_IOCTL_IOPORT_GETIRQ (port), cs), spi_pin_hook, (void *) (intptr_t) SPI_PIN_CS);
+  avr_irq_register_notify (avr_io_getirq (avr, AVR_IOCTL_IOPORT_GETIRQ (port), dc), spi_pin_hook, (void *) (intptr_t) SPI_PIN_DC);
+  // VCD signals
+  // -------------------------------------------------------------------------------------
+  avr_vcd_init (avr, argv[optind + 1], &vcd, VCD_PERIOD);
+  probeAvr = avr;
+  for (i = 0; i < 8; i++) {
+    avr_vcd_add_signal (&vcd, avr_iomem_getirq (avr, reg, "probe", i), 1, probeNames[i]);
+    avr_irq_register_notify (avr_iomem_getirq (avr, reg, "probe", i), probe_hook, (void *) (intptr_t) i);
+  }
+  avr_vcd_add_signal (&vcd, slaveIrq + SLAVE_BUS, 1, "i2c.bus");
+  avr_vcd_add_signal (&vcd, slaveIrq + SLAVE_DATA, 8, "i2c.data");
+  avr_vcd_add_signal (&vcd, avr_io_getirq (avr, AVR_IOCTL_IOPORT_GETIRQ (port), cs), 1, "spi.cs");
+  avr_vcd_add_signal (&vcd, avr_io_getirq (avr, AVR_IOCTL_IOPORT_GETIRQ (port), dc), 1, "spi.dc");
+  avr_vcd_add_signal (&vcd, avr_io_getirq (avr, AVR_IOCTL_SPI_GETIRQ (0), SPI_IRQ_OUTPUT), 8, "spi.data");
+  avr_vcd_start (&vcd);
+  // run till firmware returns from main (sleep with interrupts off) or time limit
+  // -------------------------------------------------------------------------------------
+  limit = (avr_cycle_count_t) firmware.frequency / 1000 * ms;
+  do {
+    state = avr_run (avr);
+  } while ((state != cpu_Done) && (state != cpu_Crashed) && (avr->cycle < limit));
+  avr_vcd_stop (&vcd);
+  avr_vcd_close (&vcd);
+
+  printf ("%s: %llu cycles, %lu bytes acknowledged, %s\n", argv[optind + 1],
+          (unsigned long long) avr->cycle, slaveBytes,
+          state == cpu_Crashed ? "crashed" : state == cpu_Done ? "done" : "time limit");
+  if (spiTransactions) {
+    printf ("  spi: %lu transactions, %lu command bytes, %lu data bytes, %lu in last one\n",
+            spiTransactions, spiCommands, spiData, spiLast);
+  }
+  for (i = 0; i < 8; i++) {
+    if (probeCycles[i]) {
+      printf ("  %-14s %10llu cycles\n", probeNames[i], (unsigned long long) probeCycles[i]);
+    }
+  }
+
+  return state == cpu_Crashed;
+}